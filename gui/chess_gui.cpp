@@ -9,6 +9,7 @@
 
 #include "chess/core/ch_board.h"
 #include "chess/core/ch_move.h"
+#include "chess/core/ch_movelist.h"
 #include "chess/core/ch_state.h"
 #include "chess/core/ch_bitboard.h"
 #include "chess/gen/ch_movegen.h"
@@ -25,21 +26,12 @@ inline int rank_of(int s){ return s >> 3; }
 inline int idx(int f, int r){ return (r<<3) | f; }
 
 static bool piece_at(const ch::Board& b, int sq, ch::Color& outC, ch::PieceKind& outK) {
-    ch::BB mask = ch::bit(sq);
-    if (!(b.occ_all() & mask)) return false;
+    const ch::Piece p = b.piece_on(sq);
+    if (p == ch::NoPiece) return false;
 
-    if (b.occ(ch::Color::White) & mask) {
-        outC = ch::Color::White;
-        for (int k=0;k<6;++k) {
-            if (b.bb(outC, ch::PieceKind(k)) & mask) { outK = ch::PieceKind(k); return true; }
-        }
-    } else {
-        outC = ch::Color::Black;
-        for (int k=0;k<6;++k) {
-            if (b.bb(outC, ch::PieceKind(k)) & mask) { outK = ch::PieceKind(k); return true; }
-        }
-    }
-    return false;
+    outC = ch::color_of(p);
+    outK = ch::kind_of(p);
+    return true;
 }
 
 struct PieceAtlas {
@@ -394,12 +386,11 @@ private:
         if (!piece_at(board, sq, c, k)) return;
         if (c != board.side_to_move()) return;
 
-        cachedMoves.clear();
         legalTargets.clear();
-        ch::generate_legal_moves(board, board.side_to_move(), cachedMoves);
-        for (auto& m : cachedMoves)
+        ch::for_each_legal_move(board, board.side_to_move(), [&](ch::Move m) {
             if (m.from() == sq)
                 legalTargets.push_back(m.to());
+        });
 
         selected = sq;
         dragging = true;
@@ -414,10 +405,11 @@ private:
         if (to < 0) { resetSel(); return; }
 
         // Collect all legal moves that match the drag from->to
-        std::vector<ch::Move> cands;
-        for (const auto& m : cachedMoves)
+        ch::MoveList cands;
+        ch::for_each_legal_move(board, board.side_to_move(), [&](ch::Move m) {
             if (m.from() == selected && m.to() == to)
                 cands.push_back(m);
+        });
 
         if (cands.empty()) { resetSel(); return; }
 
@@ -469,7 +461,6 @@ private:
     void resetSel() {
         selected = -1;
         legalTargets.clear();
-        cachedMoves.clear();
     }
 
     BoardView view{};
@@ -480,7 +471,7 @@ private:
     int dragFrom=-1, selected=-1;
 
     bool awaitingPromotion = false;
-    std::vector<ch::Move> pendingPromoMoves;
+    ch::MoveList pendingPromoMoves;
     int pendingFrom = -1, pendingTo = -1;
     PromotionPopup promo;
 
@@ -490,14 +481,11 @@ private:
     std::vector<ch::State> history;
     std::vector<ch::Move>  played;
 
-    std::vector<ch::Move> cachedMoves;
     std::vector<int> legalTargets;
     std::optional<std::pair<int,int>> lastMove;
 };
 
 int main() {
-    ch::init_bitboards();
-
     ch::Board guiBoard;
     guiBoard.set_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
 
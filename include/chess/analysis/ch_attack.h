@@ -21,6 +21,43 @@ namespace ch
      */
     BB attackers_to(const Board& b, int sq, Color by);
 
+    /**
+     * @brief attackers_to() with slider rays computed on @p occ instead of b.occ_all().
+     *
+     * Lets callers ask "would this square be attacked if these squares were
+     * empty / occupied" without building a modified Board (e.g. king walks,
+     * where the king itself must not block rays behind it).
+     */
+    BB attackers_to(const Board& b, int sq, Color by, BB occ);
+
+    /**
+     * @brief Compile-time-color form of attackers_to(b, sq, By, occ).
+     *
+     * Instantiated for both colors in ch_attack.cpp; side-templated callers
+     * (move generation, legality) use it to avoid the runtime color branch.
+     */
+    template <Color By>
+    BB attackers_to(const Board& b, int sq, BB occ);
+
+    extern template BB attackers_to<Color::White>(const Board&, int, BB);
+    extern template BB attackers_to<Color::Black>(const Board&, int, BB);
+
+    /**
+     * @brief Attackers of *both* colors to @p sq, slider rays computed on @p occ.
+     *
+     * Mask with b.occ(c) to split by side. Pieces removed from @p occ are not
+     * filtered out of the result (callers such as SEE mask with @p occ themselves).
+     */
+    BB attackers_to(const Board& b, int sq, BB occ);
+
+    /**
+     * @brief Bishops, rooks and queens of both colors that see @p sq through @p occ.
+     *
+     * The slider part of attackers_to(b, sq, occ); used to pick up x-ray
+     * attackers once a piece in front of them has been removed from @p occ.
+     */
+    BB slider_attackers_to(const Board& b, int sq, BB occ);
+
     /**
      * @brief True if @p side's king is currently in check.
      */
@@ -34,17 +71,49 @@ namespace ch
         return attackers_to(b, sq, by) != 0;
     }
 
+    /**
+     * @brief True if square @p sq is attacked by color @p by, sliders seeing @p occ.
+     */
+    inline bool is_attacked(const Board& b, int sq, Color by, BB occ)
+    {
+        return attackers_to(b, sq, by, occ) != 0;
+    }
+
     /**
      * @brief Squares attacked (controlled) by a *single piece* at @p fromSq.
      *
      * Notes:
-     *  - Pawns: capture directions only (they "attack" diagonals, not pushes).
+     *  - Squares occupied by @p by's own pieces are excluded.
+     *  - Pawns: both capture diagonals, occupied or not (pushes are not attacks).
      *  - Castling is not an attack; en-passant target does not change attacks.
      */
     BB attacks_from(const Board& b, Color by, PieceKind kind, int fromSq);
 
     /**
-     * @brief Union of all squares attacked by side @p by.
+     * @brief Union of all squares attacked by side @p by (own-occupied squares excluded).
+     *
+     * Computed set-wise: pawn and knight attacks as whole-bitboard shifts,
+     * sliders and king from the attack tables.
      */
     BB attacks_side(const Board& b, Color by);
+
+    /**
+     * @brief Attack maps of one side, split by attacking piece kind.
+     *
+     * Unlike attacks_side(), squares holding @p by's own pieces are kept, so
+     * the maps also say which pieces are defended.
+     */
+    struct AttackInfo
+    {
+        BB by_kind[6]{}; ///< squares attacked by each PieceKind (indexed by kind)
+        BB all = 0;      ///< union of by_kind
+        BB twice = 0;    ///< squares attacked by at least two pieces
+    };
+
+    /**
+     * @brief Fill an AttackInfo for side @p by (same set-wise kernels as attacks_side()).
+     *
+     * Two pawns hitting the same square, or two knights, count as two attackers.
+     */
+    AttackInfo attack_info(const Board& b, Color by);
 } // namespace ch
@@ -16,6 +16,7 @@
 namespace ch
 {
     class Board; // forward declaration
+    struct Pins;  // ch_pins.h
 
     /**
      * @brief Summary of check status against a side's king.
@@ -41,6 +42,26 @@ namespace ch
      */
     CheckState compute_check_state(const Board& b, Color side);
 
+    /**
+     * @brief Check status from an already computed Pins (uses pins.checkers).
+     *
+     * Generators that need both pins and check state call compute_pins() once
+     * and derive the check state from it, instead of querying the king's
+     * attackers a second time.
+     */
+    CheckState compute_check_state(const Pins& pins);
+
+    /**
+     * @brief True if pseudo-legal move @p m does not leave the mover's king attacked.
+     *
+     * @p m must come from generate_pseudo_legal_moves() (or be otherwise known
+     * pseudo-legal) for b.side_to_move(). Pins and checks are both handled by
+     * re-testing the king with the occupancy the move would produce, so no
+     * per-position pin table is needed; castling additionally requires the
+     * king not to start in, pass through or land in check.
+     */
+    bool is_legal(const Board& b, Move m);
+
     /**
      * @brief Specialized check for EP captures: ensures king is not left in check after EP.
      *
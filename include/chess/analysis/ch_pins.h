@@ -10,25 +10,29 @@
  */
 
 #include "chess/core/ch_types.h"
+#include "chess/core/ch_bitboard.h"
 
 namespace ch
 {
     class Board; // forward declaration
 
     /**
-     * @brief Info about pieces line-pinned to their own king.
+     * @brief Pins and checks against a side's king, as a few bitboards.
      *
-     *  - pinned: bitboard of all friendly pieces (excluding king) that are pinned.
-     *  - ray_to_enemy[sq]:
-     *        For a pinned piece on 'sq', a *closed* segment bitboard:
-     *            king ... pinned ... enemy_pinner
-     *        Legal moves for that piece are constrained to this segment.
-     *        For non-pinned squares, this entry is 0.
+     *  - pinned:   friendly pieces (excluding king) line-pinned to the king.
+     *  - checkers: enemy pieces currently giving check.
+     *  - line(sq): for a pinned piece on 'sq', the full line through king and
+     *              piece. The king on one end and the pinner on the other block
+     *              it, so the piece's legal squares are its moves on this line.
+     *              Looked up on demand from LINE, nothing is stored per square.
      */
     struct Pins
     {
         BB pinned = 0;
-        BB ray_to_enemy[64]{}; // closed segment: king .. enemy (includes both endpoints)
+        BB checkers = 0;
+        int king_sq = -1;
+
+        [[nodiscard]] BB line(int sq) const noexcept { return LINE[king_sq][sq]; }
     };
 
     /**
@@ -36,6 +40,21 @@ namespace ch
      *
      * Only rook / bishop / queen pins are considered (line pins).
      * Knights and pawns cannot create line pins.
+     *
+     * Set-wise: enemy sliders that would see the king on an empty board are
+     * the candidate pinners; the BETWEEN mask to each tells whether it gives
+     * check (nothing between) or pins (exactly one friendly piece between).
      */
     Pins compute_pins(const Board& b, Color side);
+
+    /**
+     * @brief Pieces of either color that stand alone between @p ksq and a slider of @p by.
+     *
+     * Only sliders that would hit @p ksq along their own line count (rook/queen
+     * on ranks and files, bishop/queen on diagonals). Seen from a side's own
+     * king with @p by = enemy, the friendly blockers are the pinned pieces;
+     * seen from the *enemy* king with @p by = side, the friendly blockers are
+     * discovered-check candidates.
+     */
+    BB slider_blockers(const Board& b, int ksq, Color by);
 } // namespace ch
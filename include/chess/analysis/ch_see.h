@@ -0,0 +1,46 @@
+#pragma once
+/**
+ * @file ch_see.h
+ * @brief Static Exchange Evaluation: material outcome of the capture sequence on one square.
+ *
+ * Both sides recapture on the destination square with their least valuable
+ * attacker, and either side may stop when continuing would lose material.
+ * X-ray attackers (sliders lined up behind a capturer) join the sequence as
+ * the pieces in front of them leave, found with an occupancy-parameterized
+ * attackers_to(). Pins are ignored. The king only captures if the opponent
+ * has no attacker left.
+ *
+ * Promotions on the first move count the promotion gain; promotions during
+ * the recapture sequence are not modeled.
+ *
+ * Implementation lives in src/analysis/ch_see.cpp
+ */
+
+#include "chess/core/ch_types.h"
+#include "chess/core/ch_move.h"
+
+namespace ch
+{
+    class Board; // forward declaration
+
+    /// Material values used by SEE (centipawns), indexed by PieceKind.
+    inline constexpr int SEE_VALUE[7] = { 100, 320, 330, 500, 900, 20000, 0 };
+
+    /**
+     * @brief Expected material gain of @p m for the side to move (may be negative).
+     *
+     * @p m must be pseudo-legal for b.side_to_move(). Works for quiet moves too
+     * (0 if the piece is safe on its destination, negative if it hangs).
+     * Castling returns 0.
+     */
+    int see(const Board& b, Move m);
+
+    /**
+     * @brief True if see(b, m) >= @p threshold.
+     *
+     * Cheaper than see(): stops as soon as the outcome relative to the
+     * threshold is decided. Use for pruning / ordering decisions like
+     * "does this capture at least not lose material" (threshold 0).
+     */
+    bool see_ge(const Board& b, Move m, int threshold);
+} // namespace ch
@@ -8,16 +8,24 @@
  *  - Precomputed leaper attack tables (KNIGHT_ATK, KING_ATK)
  *  - Diagonal masks (optional helpers for debugging/analysis)
  *  - Ray stepping helpers for sliding pieces
- *  - A one-time initializer (init_bitboards)
+ *  - Fixed-shift magic bitboard lookups for sliders (rook_attacks, bishop_attacks)
+ *  - Square-pair tables (BETWEEN, LINE) and the aligned() helper
  * 
- * Implementations are provided in ch_bitboard.cpp
+ * Masks, leaper and square-pair tables are generated at compile time (read-only data).
+ * The slider tables are filled during static initialization in ch_bitboard.cpp, so no
+ * explicit init call is needed before main().
  */
 
+#include <array>
 #include <cstdint>
 #if __has_include(<bit>)
     #include <bit> // std::popcount (C++20), if available
 #endif
 
+#if defined(CH_USE_PEXT)
+    #include <immintrin.h> // _pext_u64 (BMI2)
+#endif
+
 #include "ch_types.h"
 
 namespace ch
@@ -71,6 +79,101 @@ namespace ch
         return x;
     }
 
+    /**
+     * @brief Direction codes for ray stepping
+     * 
+     * Values correspond to square index deltas. For example, N=+8 moves one rank up,
+     * E=+1 moves one file right, NE=+9 moves one file right and one rank up, etc.
+     */
+    enum Dir { N = 8, S =- 8, E = 1, W =- 1, NE = 9, NW = 7, SE =- 7, SW =- 9 };
+
+    /**
+     * @brief Compute sliding attacks from a starting square in one direction.
+     * 
+     * Walks from @p sq in direction @p dir until the board edge or the first blocker
+     * (a set bit in @p occ). The returned mask includes the blocker square (so that
+     * captures are represented) and all empty squares up to it.
+     * 
+     * @param sq start square 0..63
+     * @param dir direction (one of N,S,E,W,NE,NW,SE,SW)
+     * @param occ occupancy bitboard of all pieces (both colors)
+     * @return bitboard of attacked squares in that direction
+     * 
+     * @note This is the slow reference walk used to build the tables below.
+     *       Hot paths should use rook_attacks() / bishop_attacks() instead.
+     */
+    [[nodiscard]] inline constexpr BB ray_attacks_from(int sq, Dir dir, BB occ) noexcept
+    {
+        // Step per axis; walking file/rank separately means no wrap checks are needed.
+        const int df = (dir == E || dir == NE || dir == SE) ? 1 : (dir == W || dir == NW || dir == SW) ? -1 : 0;
+        const int dr = (dir == N || dir == NE || dir == NW) ? 1 : (dir == S || dir == SE || dir == SW) ? -1 : 0;
+
+        BB attacks = 0;
+        for (int f = file_of(sq) + df, r = rank_of(sq) + dr;
+             static_cast<unsigned>(f) < 8u && static_cast<unsigned>(r) < 8u;
+             f += df, r += dr)
+        {
+            attacks |= bit(idx(f, r));
+            if (occ & bit(idx(f, r))) break;
+        }
+        return attacks;
+    }
+
+    namespace detail
+    {
+        // Compile-time builders for the tables below.
+
+        [[nodiscard]] constexpr std::array<BB, 8> make_file_masks() noexcept
+        {
+            std::array<BB, 8> t{};
+            for (int f = 0; f < 8; ++f)
+                for (int r = 0; r < 8; ++r) t[f] |= bit(idx(f, r));
+            return t;
+        }
+
+        [[nodiscard]] constexpr std::array<BB, 8> make_rank_masks() noexcept
+        {
+            std::array<BB, 8> t{};
+            for (int r = 0; r < 8; ++r)
+                for (int f = 0; f < 8; ++f) t[r] |= bit(idx(f, r));
+            return t;
+        }
+
+        // anti == false: A1-H8 diagonals indexed by (file + rank)
+        // anti == true:  A8-H1 diagonals indexed by (file - rank + 7)
+        [[nodiscard]] constexpr std::array<BB, 15> make_diag_masks(bool anti) noexcept
+        {
+            std::array<BB, 15> t{};
+            for (int r = 0; r < 8; ++r)
+                for (int f = 0; f < 8; ++f) t[anti ? (f - r + 7) : (f + r)] |= bit(idx(f, r));
+            return t;
+        }
+
+        // Leaper table from 8 (file, rank) offsets; off-board targets are dropped.
+        [[nodiscard]] constexpr std::array<BB, 64> make_leaper(const int (&df)[8], const int (&dr)[8]) noexcept
+        {
+            std::array<BB, 64> t{};
+            for (int s = 0; s < 64; ++s)
+            {
+                for (int i = 0; i < 8; ++i)
+                {
+                    const int f = file_of(s) + df[i], r = rank_of(s) + dr[i];
+                    if (static_cast<unsigned>(f) < 8u && static_cast<unsigned>(r) < 8u)
+                        t[s] |= bit(idx(f, r));
+                }
+            }
+            return t;
+        }
+
+        // Knight moves are (+-1, +-2) and (+-2, +-1)
+        inline constexpr int KnightDF[8] = {+1, +2, +2, +1, -1, -2, -2, -1};
+        inline constexpr int KnightDR[8] = {+2, +1, -1, -2, -2, -1, +1, +2};
+
+        // King: all (df, dr) with |df|<=1, |dr|<=1, not (0,0)
+        inline constexpr int KingDF[8] = {-1, 0, +1, -1, +1, -1, 0, +1};
+        inline constexpr int KingDR[8] = {-1, -1, -1, 0, 0, +1, +1, +1};
+    } // namespace detail
+
     /**
      * @name Precomputed board-wide masks
      * @{
@@ -80,64 +183,145 @@ namespace ch
      * @brief Mask for each file (column).
      * FILE_MASK[0] = file A, ..., FILE_MASK[7] = file H.
      */
-    extern BB FILE_MASK[8]; 
+    inline constexpr std::array<BB, 8> FILE_MASK = detail::make_file_masks();
 
     /**
      * @brief Mask for each rank (row).
      * RANK_MASK[0] = rank 1, ..., RANK_MASK[7] = rank 8.
      */
-    extern BB RANK_MASK[8];
+    inline constexpr std::array<BB, 8> RANK_MASK = detail::make_rank_masks();
 
     /**
      * @brief (Optional) Diagonal masks for A1-H8 and A8-H1 diagonals
      * Indexed 0..14; useful for analysis and "between" computations.
      */
-    extern BB DIAG_A1H8[15], DIAG_A8H1[15];
+    inline constexpr std::array<BB, 15> DIAG_A1H8 = detail::make_diag_masks(false);
+    inline constexpr std::array<BB, 15> DIAG_A8H1 = detail::make_diag_masks(true);
 
     /**
      * @brief Knight attack masks for each square, independent of occupancy.
      * KNIGHT_ATK[s] gives all squares a knight on s could attack (capture or quiet),
      * before intersecting with empty/enemy/own occupancy.
      */
-    extern BB KNIGHT_ATK[64];
+    inline constexpr std::array<BB, 64> KNIGHT_ATK = detail::make_leaper(detail::KnightDF, detail::KnightDR);
 
     /**
      * @brief King attack masks for each square, independent of occupancy.
      */
-    extern BB KING_ATK[64];
+    inline constexpr std::array<BB, 64> KING_ATK = detail::make_leaper(detail::KingDF, detail::KingDR);
     /**@} */
 
     /**
-     * @brief Direction codes for ray stepping
+     * @name Magic bitboard slider attacks
      * 
-     * Values correspond to square index deltas. For example, N=+8 moves one rank up,
-     * E=+1 moves one file right, NE=+9 moves one file right and one rank up, etc.
+     * Fixed-shift magics: every square of a slider type uses the same index width
+     * (12 bits for rooks, 9 for bishops), so the index is simply
+     * ((occ & mask) * magic) >> shift into a per-square table.
+     * Magic numbers are fixed constants; the tables are filled during static
+     * initialization of ch_bitboard.cpp, so lookups from other static initializers
+     * are not supported.
+     * 
+     * When built with CH_USE_PEXT (BMI2), the index is _pext_u64(occ, mask) instead
+     * and no magic numbers are needed; table layout is unchanged.
+     * @{
      */
-    enum Dir { N = 8, S =- 8, E = 1, W =- 1, NE = 9, NW = 7, SE =- 7, SW =- 9 };
+
+    /// Index width of the per-square rook / bishop attack tables.
+    inline constexpr int RookMagicBits = 12;
+    inline constexpr int BishopMagicBits = 9;
 
     /**
-     * @brief Compute sliding attacks from a starting square in one direction.
+     * @brief Per-square magic entry.
      * 
-     * Walks from @p sq in direction @p dir until the board edge or the first blocker
-     * (a set bit in @p occ). The returned mask includes the blocker square (so that
-     * captures are represented) and all empty squares up to it.
+     * mask: relevant blocker squares (rays from the square, board edges excluded)
+     * magic: multiplier mapping every blocker subset of @ref mask to a collision-free index
+     *        (unused with CH_USE_PEXT)
+     * attacks: this square's slice of the attack table
+     */
+    struct Magic
+    {
+        BB mask = 0;
+        BB magic = 0;
+        const BB* attacks = nullptr;
+    };
+
+    extern Magic ROOK_MAGICS[64];
+    extern Magic BISHOP_MAGICS[64];
+
+    /** @brief Index into @p m's table slice for occupancy @p occ (@p bits = table width). */
+    [[nodiscard]] inline unsigned magic_index(const Magic& m, BB occ, int bits) noexcept
+    {
+        #if defined(CH_USE_PEXT)
+            (void)bits;
+            return static_cast<unsigned>(_pext_u64(occ, m.mask));
+        #else
+            return static_cast<unsigned>(((occ & m.mask) * m.magic) >> (64 - bits));
+        #endif
+    }
+
+    /** @brief Rook attacks from @p sq for occupancy @p occ (blocker squares included). */
+    [[nodiscard]] inline BB rook_attacks(int sq, BB occ) noexcept
+    {
+        const Magic& m = ROOK_MAGICS[sq];
+        return m.attacks[magic_index(m, occ, RookMagicBits)];
+    }
+
+    /** @brief Bishop attacks from @p sq for occupancy @p occ (blocker squares included). */
+    [[nodiscard]] inline BB bishop_attacks(int sq, BB occ) noexcept
+    {
+        const Magic& m = BISHOP_MAGICS[sq];
+        return m.attacks[magic_index(m, occ, BishopMagicBits)];
+    }
+
+    /** @brief Queen attacks: union of rook and bishop attacks. */
+    [[nodiscard]] inline BB queen_attacks(int sq, BB occ) noexcept
+    {
+        return rook_attacks(sq, occ) | bishop_attacks(sq, occ);
+    }
+    /**@} */
+
+    /**
+     * @name Square-pair tables
+     * @{
+     */
+
+    /// 64x64 table of bitboards indexed by a square pair.
+    using SquarePairTable = std::array<std::array<BB, 64>, 64>;
+
+    /**
+     * @brief BETWEEN[a][b]: squares strictly between @p a and @p b if they share a
+     * file, rank or diagonal; 0 otherwise.
      * 
-     * @param sq start square 0..63
-     * @param dir direction (one of N,S,E,W,NE,NW,SE,SW)
-     * @param occ occupancy bitboard of all pieces (both colors)
-     * @return bitboard of attacked squares in that direction
+     * Generated at compile time; defined (constexpr) in ch_bitboard.cpp so the 32 KB
+     * initializer is evaluated once rather than in every translation unit.
      */
-    [[nodiscard]] BB ray_attacks_from(int sq, Dir dir, BB occ);
+    extern const SquarePairTable BETWEEN;
+
+    /**
+     * @brief LINE[a][b]: the whole edge-to-edge line through @p a and @p b (both
+     * included) if they share a file, rank or diagonal; 0 otherwise.
+     */
+    extern const SquarePairTable LINE;
 
     /**
      * @brief Mask of squares strictly between @p a and @p b if aligned (same file, rank,
      * or diagonal). Return 0 if not aligned.
      */
-    [[nodiscard]] BB between_mask(int a, int b);
+    [[nodiscard]] inline BB between_mask(int a, int b) noexcept
+    {
+        return BETWEEN[a][b];
+    }
+
+    /** @brief True if @p c lies on the line through @p a and @p b. */
+    [[nodiscard]] inline bool aligned(int a, int b, int c) noexcept
+    {
+        return (LINE[a][b] & bit(c)) != 0;
+    }
+    /**@} */
 
     /**
-     * @brief Initialize all precomputed tables and masks in this header.
-     * Call once at program startup before using any tables.
+     * @brief No-op kept for source compatibility.
+     * All tables are ready before main(); calling this is no longer required.
      */
-    void init_bitboards();
+    inline void init_bitboards() noexcept {}
 }
\ No newline at end of file
@@ -5,11 +5,15 @@
  * 
  * The board tracks:
  *   - Per-(Color, PieceKind) bitboards
+ *   - A 64-entry mailbox (piece per square) kept in sync with the bitboards
  *   - Cached occupancies (per color and all)
  *   - Side to move
  *   - Castling rights (per side, K/Q)
  *   - En-passant target square (index or -1)
  *   - Halfmove clock + fullmove number (for FEN / 50-move rule)
+ *   - Zobrist key (maintained by set_fen / make_move / unmake_move)
+ *   - Optionally (CH_ATTACK_MAPS): per-side attack maps and per-square attacker
+ *     counts, updated incrementally by every mutator
  * 
  * This class provides:
  *   - Queries used by attack generation / legality
@@ -55,6 +59,9 @@ namespace ch
             return bb_[static_cast<int>(c)][static_cast<int>(k)];
         }
 
+        /** @brief Piece on @p sq, or NoPiece if empty (O(1) mailbox lookup). */
+        [[nodiscard]] Piece piece_on(int sq) const noexcept { return mailbox_[sq]; }
+
         /** @brief Occupancy of a color (OR of all piece kinds for that color). */
         [[nodiscard]] BB occ(Color c) const noexcept { return occ_[static_cast<int>(c)]; }
 
@@ -70,6 +77,34 @@ namespace ch
         [[nodiscard]] bool castle_k(Color c) const noexcept { return castle_[static_cast<int>(c)][0]; }
         [[nodiscard]] bool castle_q(Color c) const noexcept { return castle_[static_cast<int>(c)][1]; }
 
+        /**
+         * @brief Zobrist key of the position (pieces, side to move, castling, EP file).
+         *
+         * Kept current by set_fen / make_move / unmake_move. The low-level mutation
+         * helpers below do NOT touch it; call refresh_key() after editing a position by hand.
+         */
+        [[nodiscard]] Key key() const noexcept { return key_; }
+
+        /** @brief Recompute the key from scratch (used by set_fen and debug checks). */
+        [[nodiscard]] Key compute_key() const noexcept;
+
+#ifdef CH_ATTACK_MAPS
+        /**
+         * @brief Squares attacked by color @p c, including squares of its own pieces.
+         *
+         * Same map as attack_info(b, c).all, but kept current incrementally:
+         * each mutator only re-walks the moved piece's attacks and the slider
+         * rays passing through the squares it touched.
+         */
+        [[nodiscard]] BB attack_map(Color c) const noexcept { return attacks_[static_cast<int>(c)]; }
+
+        /** @brief Number of @p c's pieces attacking @p sq. */
+        [[nodiscard]] int attacker_count(Color c, int sq) const noexcept
+        {
+            return attack_count_[static_cast<int>(c)][sq];
+        }
+#endif
+
         [[nodiscard]] std::uint16_t halfmove_clock() const noexcept { return halfmove_clock_; }
         [[nodiscard]] std::uint32_t fullmove_number() const noexcept { return fullmove_number_; }
 
@@ -90,13 +125,17 @@ namespace ch
         // -------- low-level mutation helpers --------
         // These are intentionally simple and are used by:
         //  - FEN setup
-        //  - make/unmake
-        //  - tests
+        //  - tests / position editing
         //
-        // Note: set_piece/clear_piece rebuild cached occupancies immediately.
+        // Note: set_piece/clear_piece rebuild cached occupancies (and attack
+        //       maps, if enabled) immediately and keep the mailbox in sync.
+        //       make/unmake use the cheaper incremental mutators below.
 
         void set_ep_target(int sq) noexcept { ep_sq_ = sq; }
 
+        void set_key(Key k) noexcept { key_ = k; }
+        void refresh_key() noexcept { key_ = compute_key(); }
+
         void set_castle(Color c, bool kside, bool value) noexcept
         {
             castle_[static_cast<int>(c)][kside ? 0 : 1] = value;
@@ -110,18 +149,66 @@ namespace ch
         void set_piece(Color c, PieceKind k, int sq)
         {
             bb_[static_cast<int>(c)][static_cast<int>(k)] |= bit(sq);
+            mailbox_[sq] = make_piece(c, k);
             rebuild_occ();
         }
 
         void clear_piece(Color c, PieceKind k, int sq)
         {
             bb_[static_cast<int>(c)][static_cast<int>(k)] &= ~bit(sq);
+            mailbox_[sq] = NoPiece;
             rebuild_occ();
         }
 
 
         /** @brief Remove any piece on sq (if any). */
         void clear_square(int sq);
+
+        // -------- incremental mutators (make/unmake hot path) --------
+        // Occupancies are updated with XOR deltas instead of a full rebuild.
+        // Preconditions (not checked): put_piece targets an empty square,
+        // remove_piece/move_piece act on a (c, k) piece that is really on the
+        // origin square, and move_piece's destination is empty.
+
+        void put_piece(Color c, PieceKind k, int sq) noexcept
+        {
+            const BB m = bit(sq);
+            bb_[static_cast<int>(c)][static_cast<int>(k)] ^= m;
+            occ_[static_cast<int>(c)] ^= m;
+            occ_all_ ^= m;
+            mailbox_[sq] = make_piece(c, k);
+#ifdef CH_ATTACK_MAPS
+            attacks_after_put(c, k, sq);
+#endif
+        }
+
+        void remove_piece(Color c, PieceKind k, int sq) noexcept
+        {
+            const BB m = bit(sq);
+            bb_[static_cast<int>(c)][static_cast<int>(k)] ^= m;
+            occ_[static_cast<int>(c)] ^= m;
+            occ_all_ ^= m;
+            mailbox_[sq] = NoPiece;
+#ifdef CH_ATTACK_MAPS
+            attacks_after_remove(c, k, sq);
+#endif
+        }
+
+        void move_piece(Color c, PieceKind k, int from, int to) noexcept
+        {
+#ifdef CH_ATTACK_MAPS
+            // Lift then drop: each half only touches the rays through one square
+            remove_piece(c, k, from);
+            put_piece(c, k, to);
+#else
+            const BB m = bit(from) | bit(to);
+            bb_[static_cast<int>(c)][static_cast<int>(k)] ^= m;
+            occ_[static_cast<int>(c)] ^= m;
+            occ_all_ ^= m;
+            mailbox_[from] = NoPiece;
+            mailbox_[to] = make_piece(c, k);
+#endif
+        }
        
         // -- Convenience queries (used by GUI / movegen sometimes)
         [[nodiscard]] bool occupied(int sq) const noexcept { return (occ_all_ & bit(sq)) != 0; }
@@ -131,6 +218,7 @@ namespace ch
         BB bb_[2][6]{};         ///< per-(color,kind) bitboards; kind indices 0..5
         BB occ_[2]{};           ///< cached per-color occupancy
         BB occ_all_{};          ///< cached all occupancy
+        Piece mailbox_[64];     ///< piece per square (NoPiece if empty); mirrors bb_, filled by clear()
 
         bool castle_[2][2]{{false,false},{false,false}}; ///< [color][0=K,1=Q]
         int ep_sq_{-1};         ///< en-passant target, or -1
@@ -139,6 +227,28 @@ namespace ch
         std::uint16_t halfmove_clock_{0}; ///< for 50-move rule / FEN
         std::uint32_t fullmove_number_{1}; ///< increments after Black's move
 
+        Key key_{0};            ///< Zobrist key (see key())
+
+#ifdef CH_ATTACK_MAPS
+        BB attacks_[2]{};                     ///< per-color attack map (count > 0)
+        std::uint8_t attack_count_[2][64]{};  ///< per-color attackers per square
+
+        /** @brief Rebuild attack maps and counts from scratch (setup paths). */
+        void rebuild_attacks() noexcept;
+
+        void add_attacks(Color c, BB set) noexcept;
+        void sub_attacks(Color c, BB set) noexcept;
+
+        /** @brief Re-walk slider rays through @p sq after its occupancy changed from @p occOld. */
+        void update_rays_through(int sq, BB occOld) noexcept;
+
+        /** @brief Called by put_piece once (c, k) stands on @p sq. */
+        void attacks_after_put(Color c, PieceKind k, int sq) noexcept;
+
+        /** @brief Called by remove_piece once (c, k) has left @p sq. */
+        void attacks_after_remove(Color c, PieceKind k, int sq) noexcept;
+#endif
+
         /** @brief Recompute @ref occ_ and @ref occ_all_ from bb_ arrays. */
         void rebuild_occ();
     };
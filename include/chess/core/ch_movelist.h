@@ -0,0 +1,56 @@
+#pragma once
+/**
+ * @file ch_movelist.h
+ * @brief Fixed-capacity move container with inline storage (no heap allocation).
+ *
+ * No legal chess position has more than 218 moves, so 256 slots always fit a
+ * full legal move list. A MoveList lives on the stack of the caller, which makes
+ * it cheap to create per search node and safe to use from many threads without
+ * allocator contention.
+ */
+
+#include <cassert>
+#include <cstddef>
+
+#include "chess/core/ch_move.h"
+
+namespace ch
+{
+    class MoveList
+    {
+    public:
+        static constexpr std::size_t Capacity = 256;
+
+        // User-provided so the move slots stay uninitialized (see moves_)
+        MoveList() noexcept {}
+
+        void push_back(Move m) noexcept
+        {
+            assert(size_ < Capacity && "MoveList overflow");
+            moves_[size_++] = m;
+        }
+
+        void clear() noexcept { size_ = 0; }
+
+        [[nodiscard]] std::size_t size() const noexcept { return size_; }
+        [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+
+        [[nodiscard]] Move& operator[](std::size_t i) noexcept { return moves_[i]; }
+        [[nodiscard]] Move operator[](std::size_t i) const noexcept { return moves_[i]; }
+        [[nodiscard]] Move front() const noexcept { return moves_[0]; }
+
+        [[nodiscard]] Move* begin() noexcept { return moves_; }
+        [[nodiscard]] Move* end() noexcept { return moves_ + size_; }
+        [[nodiscard]] const Move* begin() const noexcept { return moves_; }
+        [[nodiscard]] const Move* end() const noexcept { return moves_ + size_; }
+
+    private:
+        // Anonymous union: Move's default member initializer would otherwise
+        // zero all 256 slots on every construction. Only [0, size_) is read.
+        union
+        {
+            Move moves_[Capacity];
+        };
+        std::size_t size_ = 0;
+    };
+} // namespace ch
@@ -29,6 +29,7 @@ namespace ch
         std::int8_t ep_sq{-1}; // en-passant square, or -1 if none
         std::uint16_t halfmove{0}; // 50-move clock BEFORE move
         std::uint16_t fullmove{1}; // fullmove number BEFORE move
+        Key key{0}; // Zobrist key BEFORE move (restored verbatim by unmake)
 
         // For unmake (details about what the move actually did):
         PieceKind moved : 4; // moved piece kind (pre-promo for pawns)
@@ -44,6 +45,12 @@ namespace ch
     /// Undo move @p m on board @p b using the previously saved snapshot @p st.
     void unmake_move(Board& b, Move m, const State& st);
 
+    /**
+     * @brief Play @p m only if it is legal in @p b (validated without generating all moves).
+     * @return true if the move was applied (and @p st filled), false otherwise.
+     */
+    bool apply_if_legal(Board& b, Move m, State& st);
+
     /// Castling bit helpers (keep here because they're used by make/unmake and board helpers)
     inline constexpr std::uint8_t WK = 1u << 0;
     inline constexpr std::uint8_t WQ = 1u << 1;
@@ -17,6 +17,9 @@ namespace ch
      */
     using BB = std::uint64_t;
 
+    /// 64-bit Zobrist position key.
+    using Key = std::uint64_t;
+
     /**
      * @brief Side to move / piece color.
      */
@@ -30,6 +33,33 @@ namespace ch
      */
     enum class PieceKind : std::uint8_t{Pawn = 0, Knight = 1, Bishop = 2, Rook = 3, Queen = 4, King = 5, None = 6};
 
+    /**
+     * @brief Concrete piece (color + kind) packed into one byte, as stored in the board mailbox.
+     *
+     * Encoding: (color << 3) | kind. An empty square is @ref NoPiece, whose kind bits
+     * decode to PieceKind::None.
+     */
+    enum class Piece : std::uint8_t {};
+
+    inline constexpr Piece NoPiece = static_cast<Piece>(PieceKind::None);
+
+    [[nodiscard]] inline constexpr Piece make_piece(Color c, PieceKind k) noexcept
+    {
+        return static_cast<Piece>((static_cast<int>(c) << 3) | static_cast<int>(k));
+    }
+
+    /// Kind of @p p (PieceKind::None for NoPiece).
+    [[nodiscard]] inline constexpr PieceKind kind_of(Piece p) noexcept
+    {
+        return static_cast<PieceKind>(static_cast<int>(p) & 7);
+    }
+
+    /// Color of @p p (meaningless for NoPiece).
+    [[nodiscard]] inline constexpr Color color_of(Piece p) noexcept
+    {
+        return static_cast<Color>(static_cast<int>(p) >> 3);
+    }
+
     // Board constants (kept here to avoid magic numbers elsewhere)
     inline constexpr int BoardFiles = 8;
     inline constexpr int BoardRanks = 8;
@@ -0,0 +1,78 @@
+#pragma once
+/**
+ * @file ch_zobrist.h
+ * @brief Zobrist hashing keys, generated at compile time.
+ *
+ * A position key is the XOR of:
+ *  - one key per (piece, square) on the board
+ *  - the side key if Black is to move
+ *  - the castling key for the current 4-bit rights mask
+ *  - the EP-file key if an en-passant target square is set
+ *
+ * The Board keeps its key up to date through set_fen / make_move / unmake_move.
+ */
+
+#include <cstdint>
+
+#include "chess/core/ch_types.h"
+
+namespace ch
+{
+    /**
+     * @brief All Zobrist keys used by the position hash.
+     *
+     * piece is indexed by the packed Piece value ((color << 3) | kind); the unused
+     * slots (including NoPiece) are zero, so XOR-ing an empty square is a no-op.
+     * castle is indexed by the WK|WQ|BK|BQ mask and already combines the per-right keys.
+     */
+    struct ZobristKeys
+    {
+        Key piece[16][64]{};
+        Key side = 0;
+        Key castle[16]{};
+        Key ep_file[8]{};
+    };
+
+    namespace detail
+    {
+        // splitmix64: tiny, constexpr-friendly, well-distributed.
+        [[nodiscard]] constexpr Key splitmix64(Key& state) noexcept
+        {
+            Key z = (state += 0x9E3779B97F4A7C15ull);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            return z ^ (z >> 31);
+        }
+
+        [[nodiscard]] constexpr ZobristKeys make_zobrist_keys() noexcept
+        {
+            ZobristKeys z{};
+            Key state = 0x2545F4914F6CDD1Dull;
+
+            for (int c = 0; c < 2; ++c)
+                for (int k = 0; k < 6; ++k)
+                    for (int sq = 0; sq < 64; ++sq)
+                        z.piece[static_cast<int>(make_piece(static_cast<Color>(c), static_cast<PieceKind>(k)))][sq]
+                            = splitmix64(state);
+
+            z.side = splitmix64(state);
+
+            Key rights[4]{};
+            for (Key& r : rights) r = splitmix64(state);
+            for (int m = 0; m < 16; ++m)
+                for (int i = 0; i < 4; ++i)
+                    if (m & (1 << i)) z.castle[m] ^= rights[i];
+
+            for (Key& e : z.ep_file) e = splitmix64(state);
+            return z;
+        }
+    } // namespace detail
+
+    inline constexpr ZobristKeys ZOBRIST = detail::make_zobrist_keys();
+
+    /// Key for (color, kind) standing on @p sq.
+    [[nodiscard]] inline constexpr Key piece_key(Color c, PieceKind k, int sq) noexcept
+    {
+        return ZOBRIST.piece[static_cast<int>(make_piece(c, k))][sq];
+    }
+} // namespace ch
@@ -0,0 +1,30 @@
+#pragma once
+/**
+ * @file ch_checks.h
+ * @brief Generate only the legal moves that give check.
+ *
+ * Meant for quiescence / mate search, where filtering the full move list with
+ * make_move + in_check is the bottleneck. Covered:
+ *  - direct checks (moving piece attacks the enemy king from its destination)
+ *  - discovered checks (a blocker of one of our sliders leaves the line)
+ *  - promotions, per promotion piece
+ *  - en-passant, including checks discovered by the removed pawn
+ *  - castling, when the rook lands with check
+ *
+ * Implementation lives in src/gen/ch_checks.cpp
+ */
+
+#include "chess/core/ch_types.h"
+#include "chess/core/ch_movelist.h"
+
+namespace ch
+{
+    class Board; // forward declaration
+
+    /**
+     * @brief Legal moves of @p side that give check to the opposing king.
+     *
+     * Same Move encoding as generate_legal_moves(); out is cleared first.
+     */
+    void generate_legal_checks(const Board& b, Color side, MoveList& out);
+} // namespace ch
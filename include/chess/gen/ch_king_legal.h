@@ -25,4 +25,11 @@ namespace ch
      * If castling is legal, the destination squares (g1/c1 or g8/c8) are included.
      */
     BB legal_king_moves(const Board& b, Color side);
+
+    /// Compile-time-color form of legal_king_moves(); instantiated for both colors.
+    template <Color Us>
+    BB legal_king_moves(const Board& b);
+
+    extern template BB legal_king_moves<Color::White>(const Board&);
+    extern template BB legal_king_moves<Color::Black>(const Board&);
 } // namespace ch
@@ -8,6 +8,8 @@
  *  - If pinned: restrict movement to the pin ray segment
  *  - Special EP case: ensure king is safe after EP capture
  *
+ * Pawns also have a set-wise path (legal_pawn_sets) for all unpinned pawns.
+ *
  * Implementation lives in src/gen/ch_legalize.cpp
  */
 
@@ -40,4 +42,43 @@ namespace ch
         const Pins& pins,
         const CheckState& cs
     );
+
+    /**
+     * @brief Legal pawn destinations of all *unpinned* pawns of @p side, set-wise.
+     *
+     * Each set holds destination squares; the origin is the destination minus
+     * the matching delta from ch_pawn.h. Check restriction (block_mask) is
+     * applied. Pinned pawns are not included and must go through
+     * legalize_nonking_mask() one by one. Empty in double check.
+     */
+    struct PawnMoveSets
+    {
+        BB push1 = 0;   ///< single pushes (origin: to - pawn_push_delta)
+        BB push2 = 0;   ///< double pushes (origin: to - 2 * pawn_push_delta)
+        BB cap_west = 0; ///< captures towards file A (origin: to - pawn_west_delta)
+        BB cap_east = 0; ///< captures towards file H (origin: to - pawn_east_delta)
+        BB ep_from = 0; ///< unpinned pawns whose en-passant capture onto b.ep_target() is legal
+    };
+
+    PawnMoveSets legal_pawn_sets(const Board& b, Color side, const Pins& pins, const CheckState& cs);
+
+    /**
+     * @name Compile-time-color forms
+     * Same as the functions above with the moving side as a template argument,
+     * so pawn directions and ranks fold to constants. Instantiated for both
+     * colors in ch_legalize.cpp; the Color-argument forms dispatch to them.
+     * @{
+     */
+    template <Color Us>
+    BB legalize_nonking_mask(const Board& b, BB pseudo, int from, PieceKind kind,
+                             const Pins& pins, const CheckState& cs);
+
+    template <Color Us>
+    PawnMoveSets legal_pawn_sets(const Board& b, const Pins& pins, const CheckState& cs);
+
+    extern template BB legalize_nonking_mask<Color::White>(const Board&, BB, int, PieceKind, const Pins&, const CheckState&);
+    extern template BB legalize_nonking_mask<Color::Black>(const Board&, BB, int, PieceKind, const Pins&, const CheckState&);
+    extern template PawnMoveSets legal_pawn_sets<Color::White>(const Board&, const Pins&, const CheckState&);
+    extern template PawnMoveSets legal_pawn_sets<Color::Black>(const Board&, const Pins&, const CheckState&);
+    /** @} */
 } // namespace ch
\ No newline at end of file
@@ -12,17 +12,21 @@
  *  - pins /check state
  *  - king legality
  *  - non-king legalization
+ *
+ * All legal generators (move lists, counting, staged, for_each_legal_move)
+ * share one templated body in ch_movegen_detail.h; only the output policy
+ * (sink) differs. The fixed sinks are instantiated once in ch_movegen.cpp.
 */
 
+#include <type_traits>
 #include <vector>
+#include "chess/core/ch_types.h"
 #include "chess/core/ch_move.h"
-#include "chess/core/ch_move.h"
-
+#include "chess/core/ch_movelist.h"
+#include "chess/gen/ch_movegen_detail.h" // generator body, for for_each_legal_move()
 
 namespace ch
 {
-    class Board; // Forward declaration
-
     /**
      * @brief Generate all fully legal moves for @p side in position @p b.
      * @param b current position
@@ -30,4 +34,88 @@ namespace ch
      * @param out output vector (cleared and then filled)
      */
     void generate_legal_moves(const Board& b, Color side, std::vector<Move>& out);
+
+    /// Same as above, into a fixed-capacity list (no allocation). Preferred in hot paths.
+    void generate_legal_moves(const Board& b, Color side, MoveList& out);
+
+    /**
+     * @brief Number of legal moves for @p side, without emitting any Move.
+     *
+     * Popcounts the legalized destination masks; each promoting pawn move
+     * counts 4 (one per promotion piece). Equals the size of the
+     * generate_legal_moves() output. Intended for perft leaves, mobility and
+     * mate / stalemate detection.
+     */
+    int count_legal_moves(const Board& b, Color side);
+
+    /**
+     * @brief Generate pseudo-legal moves for @p side: no pin or check filtering.
+     *
+     * Every move obeys piece geometry, occupancy, en-passant and castling
+     * rights (castling path empty, rook in place), but may leave the own king
+     * in check; castling through or out of check is not filtered either.
+     * Validate each move with is_legal() (ch_legality.h) before playing it.
+     * Cheaper than generate_legal_moves() when a search cuts off after the
+     * first few moves.
+     */
+    void generate_pseudo_legal_moves(const Board& b, Color side, MoveList& out);
+
+    /**
+     * @brief True if @p m is exactly a move generate_pseudo_legal_moves() would emit
+     * for b.side_to_move(), flags included.
+     *
+     * Checks the moving piece, geometry against current occupancy, capture /
+     * special flags and promotion code directly, in constant time. Use it with
+     * is_legal() to validate moves from outside the generator (hash or killer
+     * moves, GUI and protocol input).
+     */
+    bool is_pseudo_legal(const Board& b, Move m);
+
+    /**
+     * @name Staged generation
+     * Subsets of generate_legal_moves() for callers that want the likely-best
+     * moves first and may never need the rest. Captures and quiets together
+     * give exactly the full legal move list.
+     * @{
+     */
+
+    /// Legal captures (including en-passant) and all promotions, capturing or not.
+    void generate_legal_captures(const Board& b, Color side, MoveList& out);
+
+    /// Legal non-capturing, non-promoting moves (including castling).
+    void generate_legal_quiets(const Board& b, Color side, MoveList& out);
+
+    /**
+     * @brief All legal moves when @p side is in check (see compute_check_state()).
+     *
+     * Only king moves plus captures of the checker and interpositions on
+     * CheckState::block_mask are considered. Must not be called when not in check.
+     */
+    void generate_legal_evasions(const Board& b, Color side, MoveList& out);
+    /** @} */
+
+    /**
+     * @brief Call @p f(Move) for every legal move of @p side, without storing them.
+     *
+     * Visits the same moves, in the same order, as generate_legal_moves().
+     * If @p f returns bool, returning false stops generation immediately; a
+     * void-returning @p f visits everything. The generator body is instantiated
+     * for @p f, so the call is direct and can be inlined.
+     *
+     * @return false if @p f stopped generation early, true otherwise.
+     *
+     * @p f must not modify @p b (or must restore it before returning).
+     */
+    template <class F>
+    bool for_each_legal_move(const Board& b, Color side, F&& f)
+    {
+        detail::VisitSink<std::remove_reference_t<F>> sink{ f };
+        return detail::generate_legal_for<detail::GenStage::All>(b, side, sink);
+    }
+
+    /// True if @p side has at least one legal move (stops at the first one found).
+    inline bool has_legal_move(const Board& b, Color side)
+    {
+        return !for_each_legal_move(b, side, [](Move) { return false; });
+    }
 } // namespace ch
\ No newline at end of file
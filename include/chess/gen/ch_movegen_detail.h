@@ -0,0 +1,326 @@
+#pragma once
+/**
+ * @file ch_movegen_detail.h
+ * @brief The shared legal generator body and its output policies (sinks).
+ *
+ * Not a public interface: include ch_movegen.h instead. The body lives in a
+ * header so for_each_legal_move() can instantiate it with the caller's
+ * callback and the compiler can inline that callback into the generator.
+ *
+ * Every sink hook receives a whole destination set and returns false to stop
+ * generation early:
+ *  - moves(from, quiets, captures)
+ *  - castles(from, targets)
+ *  - pawn_moves(targets, delta, capture), pawn_promotions(targets, delta, capture)
+ *  - en_passant(from, to)
+ */
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+
+#include "chess/core/ch_types.h"
+#include "chess/core/ch_move.h"
+#include "chess/core/ch_bitboard.h"
+#include "chess/core/ch_board.h"
+
+#include "chess/analysis/ch_pins.h"
+#include "chess/analysis/ch_legality.h"
+
+#include "chess/gen/ch_legalize.h"
+#include "chess/gen/ch_king_legal.h"
+
+#include "chess/pieces/ch_piece.h"
+#include "chess/pieces/ch_pawn.h"
+
+namespace ch
+{
+    namespace detail
+    {
+        template <class List>
+        inline void push_moves_from_mask(int from, BB mask, bool is_capture_mask, List& out)
+        {
+            for (BB m = mask; m; )
+            {
+                int to = lsb(m);
+                m ^= bit(to);
+                out.push_back(Move::make(from, to, is_capture_mask));
+            }
+        }
+
+        // Emit 4 promotion moves for a single (from, to) pawn move
+        template <class List>
+        inline void push_promotions(int from, int to, bool capture, List& out)
+        {
+            out.push_back(Move::make(from, to, capture, 0));
+            out.push_back(Move::make(from, to, capture, 1));
+            out.push_back(Move::make(from, to, capture, 2));
+            out.push_back(Move::make(from, to, capture, 3));
+        }
+
+        // Set-wise pawn emission: every destination in @p targets came from (to - delta)
+        template <class List>
+        inline void push_pawn_moves(BB targets, int delta, bool capture, List& out)
+        {
+            for (BB m = targets; m; )
+            {
+                int to = lsb(m); m ^= bit(to);
+                out.push_back(Move::make(to - delta, to, capture));
+            }
+        }
+
+        template <class List>
+        inline void push_pawn_promotions(BB targets, int delta, bool capture, List& out)
+        {
+            for (BB m = targets; m; )
+            {
+                int to = lsb(m); m ^= bit(to);
+                push_promotions(to - delta, to, capture, out);
+            }
+        }
+
+        // Which subset of the legal moves a generator pass emits
+        enum class GenStage : std::uint8_t
+        {
+            All,      // every legal move
+            Captures, // captures (incl. EP) and all promotions
+            Quiets,   // non-capturing, non-promoting moves (incl. castling)
+            Evasions  // side is in check: king moves, captures of the checker, interpositions
+        };
+
+        // Appends moves to a std::vector / MoveList (never stops)
+        template <class List>
+        struct PushSink
+        {
+            List& out;
+
+            bool moves(int from, BB quiets, BB captures)
+            {
+                push_moves_from_mask(from, quiets, false, out);
+                push_moves_from_mask(from, captures, true, out);
+                return true;
+            }
+            bool castles(int from, BB targets)
+            {
+                for (BB m = targets; m; )
+                {
+                    int to = lsb(m); m ^= bit(to);
+                    out.push_back(Move::make(from, to, /*capture*/false, /*promo*/ 0, /*special*/ true));
+                }
+                return true;
+            }
+            bool pawn_moves(BB targets, int delta, bool capture) { push_pawn_moves(targets, delta, capture, out); return true; }
+            bool pawn_promotions(BB targets, int delta, bool capture) { push_pawn_promotions(targets, delta, capture, out); return true; }
+            bool en_passant(int from, int to)
+            {
+                out.push_back(Move::make(from, to, /*capture*/true, /*promo*/ 0, /*special*/ true));
+                return true;
+            }
+        };
+
+        // Counts moves by popcount; a promotion counts once per promotion piece
+        struct CountSink
+        {
+            int n = 0;
+
+            bool moves(int, BB quiets, BB captures) { n += popcount(quiets) + popcount(captures); return true; }
+            bool castles(int, BB targets) { n += popcount(targets); return true; }
+            bool pawn_moves(BB targets, int, bool) { n += popcount(targets); return true; }
+            bool pawn_promotions(BB targets, int, bool) { n += 4 * popcount(targets); return true; }
+            bool en_passant(int, int) { ++n; return true; }
+        };
+
+        // Calls the visitor directly on each move, stopping when it returns false.
+        // A visitor returning void never stops generation.
+        template <class F>
+        struct VisitSink
+        {
+            F& f;
+
+            bool visit(Move m)
+            {
+                if constexpr (std::is_void_v<std::invoke_result_t<F&, Move>>) { f(m); return true; }
+                else return static_cast<bool>(f(m));
+            }
+            bool visit_mask(int from, BB mask, bool capture, bool special = false)
+            {
+                for (BB m = mask; m; )
+                {
+                    int to = lsb(m); m ^= bit(to);
+                    if (!visit(Move::make(from, to, capture, 0, special))) return false;
+                }
+                return true;
+            }
+            bool moves(int from, BB quiets, BB captures) { return visit_mask(from, quiets, false) && visit_mask(from, captures, true); }
+            bool castles(int from, BB targets) { return visit_mask(from, targets, false, /*special*/ true); }
+            bool pawn_moves(BB targets, int delta, bool capture)
+            {
+                for (BB m = targets; m; )
+                {
+                    int to = lsb(m); m ^= bit(to);
+                    if (!visit(Move::make(to - delta, to, capture))) return false;
+                }
+                return true;
+            }
+            bool pawn_promotions(BB targets, int delta, bool capture)
+            {
+                for (BB m = targets; m; )
+                {
+                    int to = lsb(m); m ^= bit(to);
+                    for (int code = 0; code < 4; ++code)
+                        if (!visit(Move::make(to - delta, to, capture, code))) return false;
+                }
+                return true;
+            }
+            bool en_passant(int from, int to) { return visit(Move::make(from, to, true, 0, /*special*/ true)); }
+        };
+
+        // Non-king destinations for one piece: restrict the pseudo mask to the stage
+        // target before legalizing, so pieces without a stage move cost next to nothing.
+        template <Color Us, class Sink, class Tag>
+        inline bool gen_piece_moves(const Board& b, Tag tag, PieceKind kind, BB target,
+                                    const Pins& pins, const CheckState& cs, const MoveOpts& opts,
+                                    BB enemyOcc, Sink& sink)
+        {
+            for (BB pcs = b.bb(Us, kind); pcs; )
+            {
+                int s = lsb(pcs); pcs ^= bit(s);
+                BB pseudo = move(tag, Us, s, b, MovePhase::All, opts) & target;
+                if (!pseudo) continue;
+                BB legal = legalize_nonking_mask<Us>(b, pseudo, s, kind, pins, cs);
+
+                if (!sink.moves(s, legal & ~enemyOcc, legal & enemyOcc)) return false;
+            }
+            return true;
+        }
+
+        // The one legal generator body: all stages, every sink, specialized per side.
+        // Returns false if the sink stopped generation.
+        template <Color Us, GenStage S, class Sink>
+        bool generate_legal_into(const Board& b, Sink& sink)
+        {
+            constexpr bool wantCaptures = (S != GenStage::Quiets);
+            constexpr bool wantQuiets = (S != GenStage::Captures);
+
+            constexpr Color them = opposite(Us);
+            const BB enemyOcc = b.occ(them);
+
+            //--- King (with castling legality) ---
+            // First: it needs no pin data, so "any legal move?" often ends here
+            if (const BB kbb = b.bb(Us, PieceKind::King))
+            {
+                const int ks = lsb(kbb);
+
+                // legal_king_moves() already:
+                //  - excludes stepping onto attacked squares
+                //  - excludes own-occupied squares
+                //  - includes castling destinations if legal
+                BB ksteps = legal_king_moves<Us>(b);
+                if constexpr (S == GenStage::Captures) ksteps &= enemyOcc;
+                if constexpr (S == GenStage::Quiets) ksteps &= ~enemyOcc;
+
+                // From e1/e8 a two-square step can only be castling (flagged for make/unmake)
+                constexpr int r = (Us == Color::White) ? 0 : 7;
+                const BB castles = (ks == idx(4, r)) ? ksteps & (bit(idx(6, r)) | bit(idx(2, r))) : 0;
+
+                if (!sink.moves(ks, ksteps & ~enemyOcc & ~castles, ksteps & enemyOcc)) return false;
+                if (!sink.castles(ks, castles)) return false;
+            }
+
+            // Precompute context for non-king pieces
+            const Pins pins = compute_pins(b, Us);
+            const CheckState cs = compute_check_state(pins);
+            assert((S != GenStage::Evasions || cs.in_check) && "evasion generator used while not in check");
+
+            // Double check: only king moves are legal
+            if (cs.double_check) return true;
+
+            MoveOpts opts; // default: no explicit castle shaping; we add castle seperately
+            opts.ep_sq = b.ep_target();
+
+            // Destination filter for pieces, in every stage: in check only squares that
+            // block or capture the checker can be legal. Pawns are split by move type below.
+            BB target = cs.in_check ? cs.block_mask : ~BB{0};
+            if constexpr (S == GenStage::Captures) target &= enemyOcc;
+            if constexpr (S == GenStage::Quiets) target &= ~b.occ_all();
+
+            if (!gen_piece_moves<Us>(b, Knight, PieceKind::Knight, target, pins, cs, opts, enemyOcc, sink)) return false;
+            if (!gen_piece_moves<Us>(b, Bishop, PieceKind::Bishop, target, pins, cs, opts, enemyOcc, sink)) return false;
+            if (!gen_piece_moves<Us>(b, Rook, PieceKind::Rook, target, pins, cs, opts, enemyOcc, sink)) return false;
+            if (!gen_piece_moves<Us>(b, Queen, PieceKind::Queen, target, pins, cs, opts, enemyOcc, sink)) return false;
+
+            // --- Pawns (unpinned: set-wise) ---
+            const PawnMoveSets ps = legal_pawn_sets<Us>(b, pins, cs);
+            constexpr BB lastRank = PAWN_LAST_RANK<Us>;
+            constexpr int up = pawn_push_delta<Us>();
+            constexpr int west = pawn_west_delta<Us>();
+            constexpr int east = pawn_east_delta<Us>();
+
+            if constexpr (wantQuiets)
+            {
+                if (!sink.pawn_moves(ps.push1 & ~lastRank, up, false)) return false;
+                if (!sink.pawn_moves(ps.push2, 2 * up, false)) return false;
+            }
+            if constexpr (wantCaptures)
+            {
+                if (!sink.pawn_promotions(ps.push1 & lastRank, up, false)) return false;
+                if (!sink.pawn_moves(ps.cap_west & ~lastRank, west, true)) return false;
+                if (!sink.pawn_moves(ps.cap_east & ~lastRank, east, true)) return false;
+                if (!sink.pawn_promotions(ps.cap_west & lastRank, west, true)) return false;
+                if (!sink.pawn_promotions(ps.cap_east & lastRank, east, true)) return false;
+
+                for (BB f = ps.ep_from; f; )
+                {
+                    int s = lsb(f); f ^= bit(s);
+                    if (!sink.en_passant(s, b.ep_target())) return false;
+                }
+            }
+
+            // --- Pawns (pinned: per piece) ---
+            // Each destination goes through the set-wise hooks with delta = to - from.
+            const int ep = b.ep_target();
+
+            for (BB pcs = b.bb(Us, PieceKind::Pawn) & pins.pinned; pcs; )
+            {
+                int s = lsb(pcs); pcs ^= bit(s);
+                BB pseudo = move<Us>(Pawn, s, b, MovePhase::All, opts);
+                BB legal = legalize_nonking_mask<Us>(b, pseudo, s, PieceKind::Pawn, pins, cs);
+
+                for (BB m = legal; m; )
+                {
+                    int to = lsb(m); m ^= bit(to);
+                    const BB tb = bit(to);
+
+                    // EP lands on an empty square, so test it before the capture flag
+                    if (to == ep)
+                    {
+                        if constexpr (wantCaptures)
+                            if (!sink.en_passant(s, to)) return false;
+                        continue;
+                    }
+
+                    const bool capture = (enemyOcc & tb) != 0;
+                    if (tb & lastRank)
+                    {
+                        // Promotions: 4 moves, all in the captures stage
+                        if constexpr (wantCaptures)
+                            if (!sink.pawn_promotions(tb, to - s, capture)) return false;
+                    }
+                    else if (capture ? wantCaptures : wantQuiets)
+                    {
+                        if (!sink.pawn_moves(tb, to - s, capture)) return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        // Runtime side -> compile-time side; returns false if the sink stopped generation
+        template <GenStage S, class Sink>
+        inline bool generate_legal_for(const Board& b, Color side, Sink& sink)
+        {
+            return side == Color::White ? generate_legal_into<Color::White, S>(b, sink)
+                                        : generate_legal_into<Color::Black, S>(b, sink);
+        }
+    } // namespace detail
+} // namespace ch
@@ -0,0 +1,129 @@
+#pragma once
+/**
+ * @file ch_perft.h
+ * @brief Perft (performance test): count leaf nodes of the legal move tree.
+ *
+ * Perft is the standard correctness + speed check for move generation:
+ * totals are compared against published values, and "divide" (per root move
+ * counts) narrows a mismatch down to a single move.
+ *
+ * The last ply is bulk-counted: at depth 1 count_legal_moves() is returned
+ * directly, without generating Moves or make_move/unmake_move on each leaf.
+ *
+ * perft_divide_parallel() spreads the tree over worker threads and can share
+ * a PerftHashTable between them; the serial functions stay the reference
+ * implementation.
+ *
+ * Implementation lives in src/perft/ch_perft.cpp
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "chess/core/ch_move.h"
+#include "chess/core/ch_types.h"
+
+namespace ch
+{
+    class Board; // forward declaration
+
+    /**
+     * @brief Number of leaf nodes @p depth plies below the position.
+     *
+     * @p b is used as scratch (make/unmake) and is restored on return.
+     * depth <= 0 returns 1.
+     */
+    std::uint64_t perft(Board& b, int depth);
+
+    /// One root move with the perft count of its subtree.
+    struct PerftDivideEntry
+    {
+        Move move;
+        std::uint64_t nodes = 0;
+    };
+
+    /**
+     * @brief Perft split by root move ("divide").
+     *
+     * Entries follow generate_legal_moves() order; their node counts sum to
+     * perft(b, depth). depth <= 0 returns an empty list.
+     */
+    std::vector<PerftDivideEntry> perft_divide(Board& b, int depth);
+
+    /**
+     * @brief Fixed-size (Zobrist key, depth) -> node count cache, shared lock-free.
+     *
+     * The entry count is a power of two, so the slot is the low bits of the key.
+     * Each slot holds two words: the full 64-bit node count and a check word,
+     * key ^ nodes with the depth mixed in. Threads read and write the words
+     * without locks; a torn entry (words from two different stores), a different
+     * position or a different depth in the same slot fails the check and is
+     * treated as a miss. A cleared slot only matches a key equal to its salted
+     * depth, which is as likely as any other key collision.
+     * Replacement is always-overwrite.
+     */
+    class PerftHashTable
+    {
+    public:
+        /// Largest power-of-two entry count that fits in @p megabytes (at least one entry).
+        explicit PerftHashTable(std::size_t megabytes);
+
+        /// True and sets @p nodes if the count for (@p key, @p depth) is stored.
+        bool probe(Key key, int depth, std::uint64_t& nodes) const noexcept;
+        void store(Key key, int depth, std::uint64_t nodes) noexcept;
+        void clear() noexcept;
+
+        std::size_t entries() const noexcept { return mask_ + 1; }
+
+    private:
+        struct Entry
+        {
+            std::atomic<std::uint64_t> check{ 0 }; // key ^ salted depth ^ nodes
+            std::atomic<std::uint64_t> nodes{ 0 };
+        };
+
+        std::unique_ptr<Entry[]> table_;
+        std::size_t mask_ = 0;
+    };
+
+    /**
+     * @brief perft() that caches subtree counts in @p tt.
+     *
+     * Same result as perft(); positions that repeat through transpositions
+     * are counted once. Depth-1 nodes are bulk-counted and never stored.
+     */
+    std::uint64_t perft_hashed(Board& b, int depth, PerftHashTable& tt);
+
+    /// Work done by one worker thread of perft_divide_parallel().
+    struct PerftThreadStats
+    {
+        std::uint64_t nodes = 0;   // leaf nodes counted by this thread
+        std::uint64_t tasks = 0;   // subtrees taken from the shared queue
+        double seconds = 0.0;      // wall time from start until the queue ran dry
+    };
+
+    struct PerftParallelResult
+    {
+        std::vector<PerftDivideEntry> divide;    // same order/counts as perft_divide()
+        std::vector<PerftThreadStats> threads;   // one entry per worker
+    };
+
+    /**
+     * @brief Multithreaded perft_divide().
+     *
+     * The tree is expanded a few plies (until there are plenty of subtrees per
+     * thread, or one ply above the leaves) and the resulting subtrees go into a
+     * shared queue. Workers pull the next subtree with an atomic counter, so a
+     * thread that finishes early keeps taking work instead of idling behind a
+     * large root move. Each worker searches on its own Board copy.
+     *
+     * @p threads <= 0 uses std::thread::hardware_concurrency().
+     * If @p tt is given, all workers search with perft_hashed() on that table.
+     * depth <= 0 returns an empty result.
+     */
+    PerftParallelResult perft_divide_parallel(const Board& b, int depth, int threads,
+                                              PerftHashTable* tt = nullptr);
+} // namespace ch
@@ -1,11 +1,11 @@
 #pragma once
 /**
  * @file ch_bishop.h
- * @brief Bishop movement masks using ray attacks.
+ * @brief Bishop movement masks using magic bitboard lookups.
  * 
  * Sliding piece logic:
- *  - Generate attack rays in each diagonal direction until a blocker.
- *  - The ray helper includes the blocker square (so captures are present).
+ *  - Look up the diagonal attack set for the current occupancy.
+ *  - The lookup includes the blocker squares (so captures are present).
  *  - Filter out own occupancy.
  *  - Then restrict to attacks-only / quiet-only depending on MovePhase.
  */
@@ -16,13 +16,7 @@ namespace ch
 {
     inline BB move(bishop_t, Color c, int fromSq, const Board& b, MovePhase phase, const MoveOpts&)
     {
-        const BB occ_all = b.occ_all();
-
-        BB atk = 0;
-        atk |= ray_attacks_from(fromSq, NE, occ_all);
-        atk |= ray_attacks_from(fromSq, NW, occ_all);
-        atk |= ray_attacks_from(fromSq, SE, occ_all);
-        atk |= ray_attacks_from(fromSq, SW, occ_all);
+        BB atk = bishop_attacks(fromSq, b.occ_all());
 
         const BB own = b.occ(c);
         const BB opp = b.occ(opposite(c));
@@ -18,64 +18,141 @@
 
 namespace ch
 {
-    /** @brief Quiet push mask (single + optional double) from @p s. */
-    inline BB pawn_quiet_mask(Color c, int s, const Board& b, const MoveOpts& o)
+    /**
+     * @name Set-wise pawn moves
+     * Destination sets for a whole bitboard of pawns at once. The origin of each
+     * destination is recovered by subtracting the matching delta.
+     * The template<Color Us> forms fold shift directions and ranks at compile
+     * time; the Color-argument forms dispatch to them.
+     * @{
+     */
+
+    /// Square delta of a single push: +8 for White, -8 for Black.
+    template <Color Us>
+    [[nodiscard]] inline constexpr int pawn_push_delta() noexcept
     {
-        BB empty = ~b.occ_all();
-        BB from = bit(s);
+        return Us == Color::White ? 8 : -8;
+    }
 
-        if (c == Color::White)
-        {
-            BB one = (from << 8) & empty;
+    [[nodiscard]] inline constexpr int pawn_push_delta(Color c) noexcept
+    {
+        return c == Color::White ? 8 : -8;
+    }
 
-            BB two = 0;
-            if (o.allow_double_push && (s >> 3) == 1)
-                two = (one << 8) & empty;
-            return one | two;
-        }
-        else
-        {
-            const BB one = (from >> 8) & empty;
+    /// Delta of a capture towards file A (White +7, Black -9).
+    template <Color Us>
+    [[nodiscard]] inline constexpr int pawn_west_delta() noexcept { return pawn_push_delta<Us>() - 1; }
+    [[nodiscard]] inline constexpr int pawn_west_delta(Color c) noexcept { return pawn_push_delta(c) - 1; }
 
-            BB two = 0;
-            if (o.allow_double_push && (s >> 3) == 6)
-                two = (one >> 8) & empty;
-            return one | two;
-        }
+    /// Delta of a capture towards file H (White +9, Black -7).
+    template <Color Us>
+    [[nodiscard]] inline constexpr int pawn_east_delta() noexcept { return pawn_push_delta<Us>() + 1; }
+    [[nodiscard]] inline constexpr int pawn_east_delta(Color c) noexcept { return pawn_push_delta(c) + 1; }
+
+    /// Rank pawns of @p Us promote on (rank 8 / rank 1).
+    template <Color Us>
+    inline constexpr BB PAWN_LAST_RANK = RANK_MASK[Us == Color::White ? 7 : 0];
+
+    /** @brief Single-push destinations of @p pawns onto @p empty squares. */
+    template <Color Us>
+    [[nodiscard]] inline BB pawn_single_pushes(BB pawns, BB empty) noexcept
+    {
+        if constexpr (Us == Color::White) return (pawns << 8) & empty;
+        else return (pawns >> 8) & empty;
     }
 
-    /** @brief Capture mask (including optional en-passant target). */
-    inline BB pawn_capture_mask(Color c, int s, const Board& b, const MoveOpts& o)
+    /** @brief Double-push destinations, given the single-push set @p single. */
+    template <Color Us>
+    [[nodiscard]] inline BB pawn_double_pushes(BB single, BB empty) noexcept
     {
-        BB enemy = b.occ(opposite(c));
-        BB from = bit(s);
+        // Only pushes that landed on rank 3 / rank 6 can continue
+        if constexpr (Us == Color::White) return ((single & RANK_MASK[2]) << 8) & empty;
+        else return ((single & RANK_MASK[5]) >> 8) & empty;
+    }
 
-        // IMPORTANT: mask source file BEFORE shifting to avoid wrap-around.
-        BB diagL = 0;
-        BB diagR = 0;   
+    /** @brief Squares attacked towards file A (mask source file BEFORE shifting). */
+    template <Color Us>
+    [[nodiscard]] inline BB pawn_attacks_west(BB pawns) noexcept
+    {
+        pawns &= ~FILE_MASK[0];
+        if constexpr (Us == Color::White) return pawns << 7;
+        else return pawns >> 9;
+    }
 
-        if (c == Color::White)
-        {
-            // up-left: +7 (must not start on file A)
-            diagL = ((from & ~FILE_MASK[0]) << 7);
-            // up-right: +9 (must not start on file H)
-            diagR = ((from & ~FILE_MASK[7]) << 9);
-        }
-        else
-        {
-            // down-left: -9 (must not start on file A)
-            diagL = ((from & ~FILE_MASK[0]) >> 9);
-            // down-right: -7 (must not start on file H)
-            diagR = ((from & ~FILE_MASK[7]) >> 7);
-        }
-        
-        BB caps = (diagL | diagR) & enemy;
+    /** @brief Squares attacked towards file H (mask source file BEFORE shifting). */
+    template <Color Us>
+    [[nodiscard]] inline BB pawn_attacks_east(BB pawns) noexcept
+    {
+        pawns &= ~FILE_MASK[7];
+        if constexpr (Us == Color::White) return pawns << 9;
+        else return pawns >> 7;
+    }
+
+    /** @brief Both capture directions of @p pawns. */
+    template <Color Us>
+    [[nodiscard]] inline BB pawn_attacks(BB pawns) noexcept
+    {
+        return pawn_attacks_west<Us>(pawns) | pawn_attacks_east<Us>(pawns);
+    }
+
+    // Runtime-color forms of the above
+    [[nodiscard]] inline BB pawn_single_pushes(Color c, BB pawns, BB empty) noexcept
+    {
+        return c == Color::White ? pawn_single_pushes<Color::White>(pawns, empty)
+                                 : pawn_single_pushes<Color::Black>(pawns, empty);
+    }
+
+    [[nodiscard]] inline BB pawn_double_pushes(Color c, BB single, BB empty) noexcept
+    {
+        return c == Color::White ? pawn_double_pushes<Color::White>(single, empty)
+                                 : pawn_double_pushes<Color::Black>(single, empty);
+    }
+
+    [[nodiscard]] inline BB pawn_attacks_west(Color c, BB pawns) noexcept
+    {
+        return c == Color::White ? pawn_attacks_west<Color::White>(pawns) : pawn_attacks_west<Color::Black>(pawns);
+    }
+
+    [[nodiscard]] inline BB pawn_attacks_east(Color c, BB pawns) noexcept
+    {
+        return c == Color::White ? pawn_attacks_east<Color::White>(pawns) : pawn_attacks_east<Color::Black>(pawns);
+    }
+
+    [[nodiscard]] inline BB pawn_attacks(Color c, BB pawns) noexcept
+    {
+        return c == Color::White ? pawn_attacks<Color::White>(pawns) : pawn_attacks<Color::Black>(pawns);
+    }
+    /** @} */
+
+    /** @brief Quiet push mask (single + optional double) from @p s. */
+    template <Color Us>
+    inline BB pawn_quiet_mask(int s, const Board& b, const MoveOpts& o)
+    {
+        const BB empty = ~b.occ_all();
+        const BB one = pawn_single_pushes<Us>(bit(s), empty);
+        return o.allow_double_push ? one | pawn_double_pushes<Us>(one, empty) : one;
+    }
+
+    /** @brief Capture mask (including optional en-passant target). */
+    template <Color Us>
+    inline BB pawn_capture_mask(int s, const Board& b, const MoveOpts& o)
+    {
+        BB targets = b.occ(opposite(Us));
 
         // En-passant: allow capturing onto ep_sq if diagonally reachable
-        if (o.ep_sq >= 0)
-            caps |= (diagL | diagR) & bit(o.ep_sq);
+        if (o.ep_sq >= 0) targets |= bit(o.ep_sq);
+
+        return pawn_attacks<Us>(bit(s)) & targets;
+    }
+
+    inline BB pawn_quiet_mask(Color c, int s, const Board& b, const MoveOpts& o)
+    {
+        return c == Color::White ? pawn_quiet_mask<Color::White>(s, b, o) : pawn_quiet_mask<Color::Black>(s, b, o);
+    }
 
-        return caps;
+    inline BB pawn_capture_mask(Color c, int s, const Board& b, const MoveOpts& o)
+    {
+        return c == Color::White ? pawn_capture_mask<Color::White>(s, b, o) : pawn_capture_mask<Color::Black>(s, b, o);
     }
 
     /**
@@ -85,14 +162,22 @@ namespace ch
      *  - Attacks: diagonal captures (and ep target if set)
      *  - All: union of the above
      */
-    inline BB move(pawn_t, Color c, int s, const Board& b, MovePhase phase, const MoveOpts& o)
+    template <Color Us>
+    inline BB move(pawn_t, int s, const Board& b, MovePhase phase, const MoveOpts& o)
     {
         switch (phase)
         {
-            case MovePhase::Quiet: return pawn_quiet_mask(c, s, b, o);
-            case MovePhase::Attacks: return pawn_capture_mask(c, s, b, o);
-            case MovePhase::All: return pawn_quiet_mask(c, s, b, o) | pawn_capture_mask(c, s, b, o);
+            case MovePhase::Quiet: return pawn_quiet_mask<Us>(s, b, o);
+            case MovePhase::Attacks: return pawn_capture_mask<Us>(s, b, o);
+            case MovePhase::All: return pawn_quiet_mask<Us>(s, b, o) | pawn_capture_mask<Us>(s, b, o);
         }
         return 0;
     }
+
+    /// Runtime-color form of move<Us>(Pawn, ...).
+    inline BB move(pawn_t, Color c, int s, const Board& b, MovePhase phase, const MoveOpts& o)
+    {
+        return c == Color::White ? move<Color::White>(Pawn, s, b, phase, o)
+                                 : move<Color::Black>(Pawn, s, b, phase, o);
+    }
 } // namespace ch
\ No newline at end of file
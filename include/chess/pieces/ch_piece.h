@@ -112,4 +112,14 @@ namespace ch
      * in the tag overloads so inlining still applies when the kind is known
      */
     [[nodiscard]] BB move(PieceKind k, Color c, int fromSq, const Board& b, MovePhase phase, const MoveOpts& o);
-} // namespace ch
\ No newline at end of file
+} // namespace ch
+
+// The tag overloads are defined inline in the per-piece headers. Pull them in here so
+// every caller sees (and can inline) the definitions; otherwise optimized builds leave
+// them unresolved at link time.
+#include "chess/pieces/ch_pawn.h"
+#include "chess/pieces/ch_knight.h"
+#include "chess/pieces/ch_bishop.h"
+#include "chess/pieces/ch_rook.h"
+#include "chess/pieces/ch_queen.h"
+#include "chess/pieces/ch_king.h"
\ No newline at end of file
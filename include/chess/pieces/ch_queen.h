@@ -1,7 +1,7 @@
 #pragma once
 /**
  * @file ch_queen.h
- * @brief Queen sliding movement masks using ray attacks (rook + bishop directions).
+ * @brief Queen sliding movement masks using magic lookups (rook + bishop directions).
  */
 
 #include "chess/pieces/ch_piece.h"
@@ -10,19 +10,7 @@ namespace ch
 {
     inline BB move(queen_t, Color c, int fromSq, const Board& b, MovePhase phase, const MoveOpts&)
     {
-        const BB occ_all = b.occ_all();
-
-        BB atk = 0;
-        // Rook directions
-        atk |= ray_attacks_from(fromSq, N, occ_all);
-        atk |= ray_attacks_from(fromSq, S, occ_all);
-        atk |= ray_attacks_from(fromSq, E, occ_all);
-        atk |= ray_attacks_from(fromSq, W, occ_all);
-        // Bishop directions
-        atk |= ray_attacks_from(fromSq, NE, occ_all);
-        atk |= ray_attacks_from(fromSq, NW, occ_all);
-        atk |= ray_attacks_from(fromSq, SE, occ_all);
-        atk |= ray_attacks_from(fromSq, SW, occ_all);
+        BB atk = queen_attacks(fromSq, b.occ_all());
 
         const BB own = b.occ(c);
         const BB opp = b.occ(opposite(c));
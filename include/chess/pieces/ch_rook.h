@@ -1,7 +1,7 @@
 #pragma once
 /**
  * @file ch_rook.h
- * @brief Rook sliding movement masks using ray attacks.
+ * @brief Rook sliding movement masks using magic bitboard lookups.
  */
 
 #include "chess/pieces/ch_piece.h"
@@ -10,13 +10,7 @@ namespace ch
 {
     inline BB move(rook_t, Color c, int fromSq, const Board& b, MovePhase phase, const MoveOpts&)
     {
-        const BB occ_all = b.occ_all();
-
-        BB atk = 0;
-        atk |= ray_attacks_from(fromSq, N, occ_all);
-        atk |= ray_attacks_from(fromSq, S, occ_all);
-        atk |= ray_attacks_from(fromSq, E, occ_all);
-        atk |= ray_attacks_from(fromSq, W, occ_all);
+        BB atk = rook_attacks(fromSq, b.occ_all());
 
         const BB own = b.occ(c);
         const BB opp = b.occ(opposite(c));
@@ -2,63 +2,68 @@
 
 #include "chess/core/ch_board.h"
 #include "chess/core/ch_bitboard.h"
-#include "chess/pieces/ch_piece.h" // move(...), MoveOpts, tags
+#include "chess/pieces/ch_pawn.h"
 
 namespace ch
 {
-    namespace
+    template <Color By>
+    BB attackers_to(const Board& b, int sq, BB occ)
     {
-        // Return squares (as a bitboard) where a WHITE pawn would stand to attack 'sq'.
-        // White pawn attacks are +7/+9, so attackers are at sq-7 and sq-9.
-        inline BB white_pawns_attacking_to(int sq) noexcept
-        {
-            const BB tgt = bit(sq);
-            const BB l = (tgt >> 7) & ~FILE_MASK[0]; // remove wrap source on file A
-            const BB r = (tgt >> 9) & ~FILE_MASK[7]; // remove wrap source on file H
-            return l | r;
-        }
+        BB attackers = 0;
 
-        // Return squares (as a bitboard) where a BLACK pawn would stand to attack 'sq'.
-        // Black pawn attacks are -7/-9, so attackers are at sq+7 and sq+9.
-        inline BB black_pawns_attacking_to(int sq) noexcept
-        {
-            const BB tgt = bit(sq);
-            const BB l = (tgt << 9) & ~FILE_MASK[0]; // remove wrap source on file A
-            const BB r = (tgt << 7) & ~FILE_MASK[7]; // remove wrap source on file H
-            return l | r;
-        }
-    } // namespace
+        // Knights / Kings
+        attackers |= KNIGHT_ATK[sq] & b.bb(By, PieceKind::Knight);
+        attackers |= KING_ATK[sq] & b.bb(By, PieceKind::King);
+
+        // A pawn of 'By' attacks sq iff a pawn of the other color on sq would attack it
+        attackers |= pawn_attacks<opposite(By)>(bit(sq)) & b.bb(By, PieceKind::Pawn);
+
+        // Sliders: attacks from target outward; first blocker of the right type attacks sq
+        BB bishop = b.bb(By, PieceKind::Bishop);
+        BB rooks = b.bb(By, PieceKind::Rook);
+        BB queens = b.bb(By, PieceKind::Queen);
+
+        attackers |= bishop_attacks(sq, occ) & (bishop | queens);
+        attackers |= rook_attacks(sq, occ) & (rooks | queens);
+
+        return attackers;
+    }
+
+    template BB attackers_to<Color::White>(const Board&, int, BB);
+    template BB attackers_to<Color::Black>(const Board&, int, BB);
 
     BB attackers_to(const Board& b, int sq, Color by)
     {
-        BB occ = b.occ_all();
-        BB attackers = 0;
+        return attackers_to(b, sq, by, b.occ_all());
+    }
 
-        // Knights / Kings
-        attackers |= KNIGHT_ATK[sq] & b.bb(by, PieceKind::Knight);
-        attackers |= KING_ATK[sq] & b.bb(by,PieceKind::King);
+    BB attackers_to(const Board& b, int sq, Color by, BB occ)
+    {
+        return by == Color::White ? attackers_to<Color::White>(b, sq, occ)
+                                  : attackers_to<Color::Black>(b, sq, occ);
+    }
 
-        if (by == Color::White) attackers |= white_pawns_attacking_to(sq) & b.bb(by, PieceKind::Pawn);
-        else                    attackers |= black_pawns_attacking_to(sq) & b.bb(by, PieceKind::Pawn);
+    BB slider_attackers_to(const Board& b, int sq, BB occ)
+    {
+        const BB queens = b.bb(Color::White, PieceKind::Queen) | b.bb(Color::Black, PieceKind::Queen);
+        const BB diag = b.bb(Color::White, PieceKind::Bishop) | b.bb(Color::Black, PieceKind::Bishop) | queens;
+        const BB orth = b.bb(Color::White, PieceKind::Rook) | b.bb(Color::Black, PieceKind::Rook) | queens;
 
-        // Sliders: ray from target outward; first blocker of the right type attacks sq
-        BB bishop = b.bb(by, PieceKind::Bishop);
-        BB rooks = b.bb(by, PieceKind::Rook);
-        BB queens = b.bb(by, PieceKind::Queen);
+        return (bishop_attacks(sq, occ) & diag) | (rook_attacks(sq, occ) & orth);
+    }
 
-        // Diagonals
-        {
-            BB rays = ray_attacks_from(sq, NE, occ) | ray_attacks_from(sq, NW, occ)
-                    | ray_attacks_from(sq, SE, occ) | ray_attacks_from(sq, SW, occ);
-            attackers |= rays & (bishop | queens);
-        }
+    BB attackers_to(const Board& b, int sq, BB occ)
+    {
+        const BB knights = b.bb(Color::White, PieceKind::Knight) | b.bb(Color::Black, PieceKind::Knight);
+        const BB kings = b.bb(Color::White, PieceKind::King) | b.bb(Color::Black, PieceKind::King);
 
-        // Orthogonals
-        {
-            BB rays = ray_attacks_from(sq, N, occ) | ray_attacks_from(sq, S, occ)
-                    | ray_attacks_from(sq, E, occ) | ray_attacks_from(sq, W, occ);
-            attackers |= rays & (rooks | queens);
-        }
+        // Pawns: one lookup per color, reversed direction as in the single-color form
+        BB attackers = pawn_attacks<Color::Black>(bit(sq)) & b.bb(Color::White, PieceKind::Pawn);
+        attackers |= pawn_attacks<Color::White>(bit(sq)) & b.bb(Color::Black, PieceKind::Pawn);
+
+        attackers |= KNIGHT_ATK[sq] & knights;
+        attackers |= KING_ATK[sq] & kings;
+        attackers |= slider_attackers_to(b, sq, occ);
 
         return attackers;
     }
@@ -71,76 +76,150 @@ namespace ch
         return attackers_to(b, ks, opposite(side)) != 0;
     }
 
-    // --------- NEW: attacks_from / attacks_side ------------------------
-    BB attacks_from(const Board& b, Color by, PieceKind kind, int fromSq)
+    namespace
     {
-        // For control/attacks, castling/EP don't matter; keep zeroed opts.
+        // Knight jumps as whole-bitboard shifts; the source mask drops the files
+        // that would wrap around the board edge.
+        struct KnightJump
+        {
+            int shift;   ///< positive: left shift, negative: right shift
+            BB from_mask;
+        };
 
-        MoveOpts o;
+        constexpr BB NOT_A = ~FILE_MASK[0];
+        constexpr BB NOT_AB = ~(FILE_MASK[0] | FILE_MASK[1]);
+        constexpr BB NOT_H = ~FILE_MASK[7];
+        constexpr BB NOT_GH = ~(FILE_MASK[6] | FILE_MASK[7]);
+
+        constexpr KnightJump KNIGHT_JUMPS[8] = {
+            { +17, NOT_H }, { +15, NOT_A }, { +10, NOT_GH }, { +6, NOT_AB },
+            { -6, NOT_GH }, { -10, NOT_AB }, { -15, NOT_H }, { -17, NOT_A },
+        };
+
+        inline BB knight_jump(BB knights, const KnightJump& j) noexcept
+        {
+            const BB src = knights & j.from_mask;
+            return j.shift > 0 ? src << j.shift : src >> -j.shift;
+        }
+
+        // Accumulates attack sets, tracking squares hit more than once
+        struct AttackAcc
+        {
+            BB all = 0;
+            BB twice = 0;
+
+            void add(BB a) noexcept
+            {
+                twice |= all & a;
+                all |= a;
+            }
+        };
+    } // namespace
+
+    BB attacks_from(const Board& b, Color by, PieceKind kind, int fromSq)
+    {
+        // For control/attacks, castling/EP don't matter
+        BB atk = 0;
         switch (kind)
         {
-            case PieceKind::Pawn:
-                // Only the capture directions count as "attacks"
-                return move(Pawn, by, fromSq, b, MovePhase::Attacks, o);
-            case PieceKind::Knight:
-                return move(Knight, by, fromSq, b, MovePhase::All, o);
-            case PieceKind::Bishop:
-                return move(Bishop, by, fromSq, b, MovePhase::All, o);
-            case PieceKind::Rook:
-                return move(Rook, by, fromSq, b, MovePhase::All, o);
-            case PieceKind::Queen:
-                return move(Queen, by, fromSq, b, MovePhase::All, o);
-            case PieceKind::King:
-                // King attacks = adjacent squares; do NOT include castling
-                return KING_ATK[fromSq] & ~b.occ(by);
+            case PieceKind::Pawn:   atk = pawn_attacks(by, bit(fromSq)); break;
+            case PieceKind::Knight: atk = KNIGHT_ATK[fromSq]; break;
+            case PieceKind::Bishop: atk = bishop_attacks(fromSq, b.occ_all()); break;
+            case PieceKind::Rook:   atk = rook_attacks(fromSq, b.occ_all()); break;
+            case PieceKind::Queen:  atk = queen_attacks(fromSq, b.occ_all()); break;
+            case PieceKind::King:   atk = KING_ATK[fromSq]; break;
 
             case PieceKind::None:
             default:
                 return 0;
         }
+        return atk & ~b.occ(by);
     }
 
     BB attacks_side(const Board& b, Color by)
     {
-        BB all = 0;
-        
-        for (BB pcs = b.bb(by,PieceKind::Knight); pcs; )
+#ifdef CH_ATTACK_MAPS
+        return b.attack_map(by) & ~b.occ(by);
+#else
+        const BB occ = b.occ_all();
+
+        BB all = pawn_attacks(by, b.bb(by, PieceKind::Pawn));
+
+        const BB knights = b.bb(by, PieceKind::Knight);
+        for (const KnightJump& j : KNIGHT_JUMPS)
+            all |= knight_jump(knights, j);
+
+        const BB queens = b.bb(by, PieceKind::Queen);
+        for (BB pcs = b.bb(by, PieceKind::Bishop) | queens; pcs; )
         {
             int s = lsb(pcs); pcs ^= bit(s);
-            all |= attacks_from(b, by, PieceKind::Knight, s);
+            all |= bishop_attacks(s, occ);
         }
-        
-        for (BB pcs = b.bb(by, PieceKind::Bishop); pcs; )
+        for (BB pcs = b.bb(by, PieceKind::Rook) | queens; pcs; )
         {
             int s = lsb(pcs); pcs ^= bit(s);
-            all |= attacks_from(b, by, PieceKind::Bishop, s);
+            all |= rook_attacks(s, occ);
         }
-        
-        for (BB pcs = b.bb(by, PieceKind::Rook); pcs; )
+
+        const BB k = b.bb(by, PieceKind::King);
+        if (k) all |= KING_ATK[lsb(k)];
+
+        return all & ~b.occ(by);
+#endif
+    }
+
+    AttackInfo attack_info(const Board& b, Color by)
+    {
+        const BB occ = b.occ_all();
+        AttackInfo info;
+        AttackAcc acc;
+
+        // Pawns: west and east captures are each one set; a square in both is hit twice
         {
-            int s = lsb(pcs); pcs ^= bit(s);
-            all |= attacks_from(b, by, PieceKind::Rook, s);
+            const BB pawns = b.bb(by, PieceKind::Pawn);
+            const BB west = pawn_attacks_west(by, pawns);
+            const BB east = pawn_attacks_east(by, pawns);
+            acc.add(west);
+            acc.add(east);
+            info.by_kind[static_cast<int>(PieceKind::Pawn)] = west | east;
         }
-        
-        for (BB pcs = b.bb(by, PieceKind::Queen); pcs; )
+
         {
-            int s = lsb(pcs); pcs ^= bit(s);
-            all |= attacks_from(b, by, PieceKind::Queen, s);
+            const BB knights = b.bb(by, PieceKind::Knight);
+            BB kn = 0;
+            for (const KnightJump& j : KNIGHT_JUMPS)
+            {
+                const BB a = knight_jump(knights, j);
+                acc.add(a);
+                kn |= a;
+            }
+            info.by_kind[static_cast<int>(PieceKind::Knight)] = kn;
         }
-        
-        for (BB pcs = b.bb(by, PieceKind::Pawn); pcs; )
+
+        for (PieceKind kind : { PieceKind::Bishop, PieceKind::Rook, PieceKind::Queen })
         {
-            int s = lsb(pcs); pcs ^= bit(s);
-            all |= attacks_from(b, by, PieceKind::Pawn, s);
+            BB kAtk = 0;
+            for (BB pcs = b.bb(by, kind); pcs; )
+            {
+                int s = lsb(pcs); pcs ^= bit(s);
+                const BB a = kind == PieceKind::Bishop ? bishop_attacks(s, occ)
+                           : kind == PieceKind::Rook   ? rook_attacks(s, occ)
+                                                       : queen_attacks(s, occ);
+                acc.add(a);
+                kAtk |= a;
+            }
+            info.by_kind[static_cast<int>(kind)] = kAtk;
         }
-        
+
         {
-            BB k = b.bb(by, PieceKind::King);
-            if (k) {
-                int s = lsb(k);
-                all |= attacks_from(b, by, PieceKind::King, s);
-            }
+            const BB k = b.bb(by, PieceKind::King);
+            const BB a = k ? KING_ATK[lsb(k)] : 0;
+            acc.add(a);
+            info.by_kind[static_cast<int>(PieceKind::King)] = a;
         }
-        return all;
+
+        info.all = acc.all;
+        info.twice = acc.twice;
+        return info;
     }
-} // namespace ch
\ No newline at end of file
+} // namespace ch
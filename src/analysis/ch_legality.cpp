@@ -3,20 +3,13 @@
 #include "chess/core/ch_board.h"
 #include "chess/core/ch_bitboard.h"
 #include "chess/analysis/ch_attack.h"
+#include "chess/analysis/ch_pins.h"
 
 namespace ch
 {
-    CheckState compute_check_state(const Board& b, Color side)
+    // in_check / double_check / checker_sq / block_mask from the king's checkers
+    static inline void fill_checks(CheckState& cs, BB checkers)
     {
-        CheckState cs{};
-
-        BB kbb = b.bb(side, PieceKind::King);
-        if(!kbb) return cs; // degenerate
-
-        cs.king_sq = lsb(kbb);
-
-        // who attacks our king?
-        BB checkers = attackers_to(b,cs.king_sq, opposite(side));
         const int n = popcount(checkers);
         cs.in_check = (n > 0);
         cs.double_check = (n >= 2);
@@ -30,6 +23,68 @@ namespace ch
                 between_mask(cs.king_sq, cs.checker_sq)
                 | bit(cs.checker_sq);
         }
+    }
+
+    CheckState compute_check_state(const Board& b, Color side)
+    {
+        CheckState cs{};
+
+        BB kbb = b.bb(side, PieceKind::King);
+        if(!kbb) return cs; // degenerate
+
+        cs.king_sq = lsb(kbb);
+
+        // who attacks our king?
+        BB checkers = attackers_to(b,cs.king_sq, opposite(side));
+        fill_checks(cs, checkers);
+        return cs;
+    }
+
+    CheckState compute_check_state(const Pins& pins)
+    {
+        CheckState cs{};
+        if (pins.king_sq < 0) return cs; // degenerate
+
+        cs.king_sq = pins.king_sq;
+        fill_checks(cs, pins.checkers);
         return cs;
     }
+
+    bool is_legal(const Board& b, Move m)
+    {
+        const Color side = b.side_to_move();
+        const Color them = opposite(side);
+        const int from = m.from();
+        const int to = m.to();
+
+        const BB kbb = b.bb(side, PieceKind::King);
+        if (!kbb) return true; // degenerate: nothing to protect
+        const int ks = lsb(kbb);
+
+        if (from == ks)
+        {
+            if (m.is_special())
+            {
+                // Castling: king may not start in, pass through or land on an attacked square
+                const int step = (to > from) ? 1 : -1;
+                for (int sq = from; sq != to + step; sq += step)
+                    if (is_attacked(b, sq, them)) return false;
+                return true;
+            }
+            // King is lifted so it does not shield squares behind it on a checking line
+            return !is_attacked(b, to, them, b.occ_all() & ~kbb);
+        }
+
+        // Position after the move, as far as attacks on our king are concerned
+        BB occ = (b.occ_all() & ~bit(from)) | bit(to);
+        BB captured = bit(to);
+        if (m.is_special() && kind_of(b.piece_on(from)) == PieceKind::Pawn)
+        {
+            const int cap_sq = (side == Color::White) ? (to - 8) : (to + 8);
+            occ &= ~bit(cap_sq);
+            captured = bit(cap_sq);
+        }
+
+        return (attackers_to(b, ks, them, occ) & ~captured) == 0;
+    }
 } // namespace ch
\ No newline at end of file
@@ -2,116 +2,59 @@
 
 #include "chess/core/ch_board.h"
 #include "chess/core/ch_bitboard.h"
+#include "chess/pieces/ch_pawn.h"
 
 namespace ch
 {
-    namespace
-    {
-        // Step from sq by dir, but stop if we wrap across files.
-        // Returns next square index or -1 if stepping leaves the board.
-        inline int step_sq(int sq, Dir dir) noexcept
-        {
-            const int to = sq + static_cast<int>(dir);
-
-            if (to < 0 || to >= 64) return -1;
-
-            // File-wrap prevention for E/W and diagonals
-            const int f0 = sq & 7;
-            const int f1 = to & 7;
-            const int df = f1 - f0;
-
-            switch (dir)
-            {
-                case E:  if (df != 1)  return -1; break;
-                case W:  if (df != -1) return -1; break;
-                case NE: if (df != 1)  return -1; break;
-                case NW: if (df != -1) return -1; break;
-                case SE: if (df != 1)  return -1; break;
-                case SW: if (df != -1) return -1; break;
-                case N:
-                case S:
-                default: break;
-            }
-            return to;
-        }
-
-        inline bool is_slider_pinner(PieceKind k, Dir dir) noexcept
-        {
-            const bool diag = (dir == NE || dir == NW || dir == SE || dir == SW);
-            if (k == PieceKind::Queen) return true;
-            if (diag) return k == PieceKind::Bishop;
-            return k == PieceKind::Rook;
-        }
-
-        inline bool piece_on(const Board& b, int sq, Color c, PieceKind k) noexcept
-        {
-            return (b.bb(c, k) & bit(sq)) != 0;
-        }
-    } // namespace
-
-    Pins compute_pins(const Board&b, Color side)
+    Pins compute_pins(const Board& b, Color side)
     {
         Pins out{};
 
-        const Color them = opposite(side);
-        const BB kingBB  = b.bb(side, PieceKind::King);
+        const BB kingBB = b.bb(side, PieceKind::King);
         if (!kingBB) return out;
 
+        const Color them = opposite(side);
         const int ks = lsb(kingBB);
+        out.king_sq = ks;
 
-        const Dir dirs[8] = { N, S, E, W, NE, NW, SE, SW };
+        // Enemy sliders aligned with the king on an empty board (x-ray through everything)
+        const BB queens = b.bb(them, PieceKind::Queen);
+        const BB snipers = (rook_attacks(ks, 0) & (b.bb(them, PieceKind::Rook) | queens))
+                         | (bishop_attacks(ks, 0) & (b.bb(them, PieceKind::Bishop) | queens));
+        const BB occ = b.occ_all();
 
-        for (Dir dir : dirs)
+        for (BB s = snipers; s; )
         {
-            int sq = ks;
-            int first_friend = -1;
+            const int sq = lsb(s); s ^= bit(sq);
+            const BB between = BETWEEN[ks][sq] & occ;
 
-            // Walk outwards
-            while (true)
-            {
-                sq = step_sq(sq, dir);
-                if (sq < 0) break;
+            if (!between) out.checkers |= bit(sq);                       // open line: check
+            else if (!(between & (between - 1)) && (between & b.occ(side))) // one friendly piece: pin
+                out.pinned |= between;
+        }
 
-                const BB m = bit(sq);
-                if (!(b.occ_all() & m))
-                    continue; // empty
+        // Non-slider checkers
+        out.checkers |= KNIGHT_ATK[ks] & b.bb(them, PieceKind::Knight);
+        out.checkers |= pawn_attacks(side, bit(ks)) & b.bb(them, PieceKind::Pawn);
 
-                // Occupied:
-                if (b.occ(side) & m)
-                {
-                    // First friendly piece could be pinned; second friendly breaks the ray.
-                    if (first_friend == -1) first_friend = sq;
-                    else break;
-                }
-                else
-                {
-                    // Enemy piece. If we have a candidate pinned piece and this enemy is a pinner, record.
-                    if (first_friend != -1)
-                    {
-                        PieceKind enemyKind = PieceKind::None;
-                        for (int k = 0; k < 6; ++k)
-                        {
-                            if (piece_on(b, sq, them, static_cast<PieceKind>(k)))
-                            {
-                                enemyKind = static_cast<PieceKind>(k);
-                                break;
-                            }
-                        }
+        return out;
+    }
 
-                        if (enemyKind != PieceKind::None && is_slider_pinner(enemyKind, dir))
-                        {
-                            out.pinned |= bit(first_friend);
+    BB slider_blockers(const Board& b, int ksq, Color by)
+    {
+        const BB queens = b.bb(by, PieceKind::Queen);
+        const BB snipers = (rook_attacks(ksq, 0) & (b.bb(by, PieceKind::Rook) | queens))
+                         | (bishop_attacks(ksq, 0) & (b.bb(by, PieceKind::Bishop) | queens));
+        const BB occ = b.occ_all();
 
-                            // Closed segment king..enemy (includes endpoints)
-                            BB seg = between_mask(ks, sq) | bit(ks) | bit(sq);
-                            out.ray_to_enemy[first_friend] = seg;
-                        }
-                    }
-                    break; // ray blocked by enemy piece regardless
-                }
-            }
+        BB blockers = 0;
+        for (BB s = snipers; s; )
+        {
+            const int sq = lsb(s); s ^= bit(sq);
+            const BB between = BETWEEN[ksq][sq] & occ;
+            if (between && !(between & (between - 1))) // exactly one piece in the way
+                blockers |= between;
         }
-
-        return out;
+        return blockers;
     }
 } // namespace ch
\ No newline at end of file
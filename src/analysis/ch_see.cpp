@@ -0,0 +1,159 @@
+#include "chess/analysis/ch_see.h"
+
+#include "chess/core/ch_board.h"
+#include "chess/core/ch_bitboard.h"
+#include "chess/analysis/ch_attack.h"
+
+#include <algorithm>
+
+namespace ch
+{
+    namespace
+    {
+        inline int value_of(PieceKind k) noexcept { return SEE_VALUE[static_cast<int>(k)]; }
+
+        // Initial exchange state after 'm' is played on the board's occupancy
+        struct SeeStart
+        {
+            int captured = 0; // material won by the move itself (incl. promotion gain)
+            int on_square = 0; // value of the piece now standing on 'to'
+            BB occ = 0;        // occupancy after the move
+        };
+
+        SeeStart see_start(const Board& b, Move m)
+        {
+            const int from = m.from();
+            const int to = m.to();
+            const Color side = b.side_to_move();
+            const PieceKind moved = kind_of(b.piece_on(from));
+
+            SeeStart s;
+            s.occ = b.occ_all() & ~bit(from);
+            s.on_square = value_of(moved);
+
+            if (m.is_special() && moved == PieceKind::Pawn)
+            {
+                // En-passant: the captured pawn is not on 'to'
+                s.captured = value_of(PieceKind::Pawn);
+                s.occ &= ~bit(to - (side == Color::White ? 8 : -8));
+            }
+            else if (m.is_capture())
+                s.captured = value_of(kind_of(b.piece_on(to)));
+
+            const int toRank = rank_of(to);
+            if (moved == PieceKind::Pawn && (toRank == 0 || toRank == 7))
+            {
+                const int promo = value_of(promo_code_to_kind(static_cast<std::uint8_t>(m.promo_code())));
+                s.captured += promo - value_of(PieceKind::Pawn);
+                s.on_square = promo;
+            }
+            return s;
+        }
+
+        // Least valuable attacker of 'side' among 'attackers'; returns its kind and square
+        inline PieceKind least_valuable(const Board& b, BB attackers, Color side, int& sq)
+        {
+            for (int k = 0; k < 6; ++k)
+            {
+                const BB set = attackers & b.bb(side, static_cast<PieceKind>(k));
+                if (set)
+                {
+                    sq = lsb(set);
+                    return static_cast<PieceKind>(k);
+                }
+            }
+            return PieceKind::None;
+        }
+
+        inline bool is_castle(const Board& b, Move m)
+        {
+            return m.is_special() && kind_of(b.piece_on(m.from())) == PieceKind::King;
+        }
+    } // namespace
+
+    int see(const Board& b, Move m)
+    {
+        if (is_castle(b, m)) return 0;
+
+        const int to = m.to();
+        SeeStart s = see_start(b, m);
+
+        // gain[d]: material balance for the side making capture d, if the sequence stopped there
+        int gain[32];
+        int d = 0;
+        gain[0] = s.captured;
+
+        BB occ = s.occ;
+        BB attackers = attackers_to(b, to, occ) & occ;
+        Color side = opposite(b.side_to_move());
+        int onSquare = s.on_square;
+
+        while (d < 31)
+        {
+            int sq = -1;
+            const PieceKind k = least_valuable(b, attackers, side, sq);
+            if (k == PieceKind::None) break;
+
+            // King may not capture into a square the opponent still covers
+            if (k == PieceKind::King && (attackers & b.occ(opposite(side)))) break;
+
+            ++d;
+            gain[d] = onSquare - gain[d - 1];
+            onSquare = value_of(k);
+
+            occ &= ~bit(sq);
+            attackers = (attackers | slider_attackers_to(b, to, occ)) & occ;
+            side = opposite(side);
+        }
+
+        // Each side picks the better of stopping or continuing
+        while (d > 0)
+        {
+            gain[d - 1] = -std::max(-gain[d - 1], gain[d]);
+            --d;
+        }
+        return gain[0];
+    }
+
+    bool see_ge(const Board& b, Move m, int threshold)
+    {
+        if (is_castle(b, m)) return 0 >= threshold;
+
+        const int to = m.to();
+        const SeeStart s = see_start(b, m);
+
+        // 'swap' is what the side to move in the exchange must still win back
+        int swap = s.captured - threshold;
+        if (swap < 0) return false;          // even an uncontested capture is not enough
+
+        swap = s.on_square - swap;
+        if (swap <= 0) return true;          // losing the moved piece still clears the bar
+
+        BB occ = s.occ;
+        BB attackers = attackers_to(b, to, occ) & occ;
+        Color side = b.side_to_move();
+        bool res = true;
+
+        while (true)
+        {
+            side = opposite(side);
+            attackers &= occ;
+
+            int sq = -1;
+            const PieceKind k = least_valuable(b, attackers, side, sq);
+            if (k == PieceKind::None) break;
+
+            // A king recapture only stands if the other side has nothing left
+            if (k == PieceKind::King)
+                return (attackers & b.occ(opposite(side))) ? res : !res;
+
+            res = !res;
+            swap = value_of(k) - swap;
+            if (swap < static_cast<int>(res)) break;
+
+            occ &= ~bit(sq);
+            attackers |= slider_attackers_to(b, to, occ);
+        }
+        return res;
+    }
+} // namespace ch
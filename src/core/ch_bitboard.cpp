@@ -1,163 +1,180 @@
 #include "chess/core/ch_bitboard.h"
 
-#include <cstdlib> // std::abs
+#include <cassert>
 
 namespace ch
 {
-    //=========== Storage for globals declared in the header ===============
-    BB FILE_MASK[8];
-    BB RANK_MASK[8];
-    BB DIAG_A1H8[15], DIAG_A8H1[15];
-    BB KNIGHT_ATK[64];
-    BB KING_ATK[64];
-
-    static inline bool on_board_fr(int f, int r)
-    {
-        return (unsigned)f < 8u && (unsigned)r < 8u;
-    }
-
-    static inline int to_sq(int f, int r) { return (r << 3) | f; }
-
-    // For E/W and diagonals, ensure we didn't wrap across the board
-    static inline bool step_respects_edge(int prev, int now, Dir dir)
+    namespace
     {
-        // Vertical moves (N/S) don't change file; no wrap possible.
-        if (dir == N || dir == S) return true;
-
-        const int pf = file_of(prev), nf = file_of(now);
-        const int df = std::abs(nf - pf);
-
-        // Horizontal (E/W): file must change by exactly 1 each step.
-        if (dir == E || dir == W) return df == 1;
-
-        // Diagonals: file must also change by exactly 1 each step.
-        return df == 1;
-    }
-
-    // ================= Precompute masks/tables ==================
-    static void build_files_ranks()
-    {
-        for (int f = 0; f < 8; ++f)
+        // Empty-board slider attacks for the square-pair tables (compile time only).
+        constexpr BB rook_rays(int sq, BB occ)
         {
-            BB m = 0;
-            for (int r = 0; r < 8; ++r) m |= (1ull << to_sq(f, r));
-            FILE_MASK[f] = m;
+            return ray_attacks_from(sq, N, occ) | ray_attacks_from(sq, S, occ)
+                 | ray_attacks_from(sq, E, occ) | ray_attacks_from(sq, W, occ);
         }
 
-        for (int r = 0; r < 8; ++r)
+        constexpr BB bishop_rays(int sq, BB occ)
         {
-            BB m = 0;
-            for (int f = 0; f < 8; ++f) m |= (1ull << to_sq(f, r));
-            RANK_MASK[r] = m;
+            return ray_attacks_from(sq, NE, occ) | ray_attacks_from(sq, NW, occ)
+                 | ray_attacks_from(sq, SE, occ) | ray_attacks_from(sq, SW, occ);
         }
-    }
-
-    static void build_diagonals()
-    {
-        // A1-H8: index by (file + rank) in [0..14]
-        for (int i = 0; i < 15; ++i) DIAG_A1H8[i] = 0;
-        for (int r = 0; r < 8; ++r)
-            for (int f = 0; f < 8; ++f)
-                DIAG_A1H8[f + r] |= (1ull << to_sq(f, r));
-
-        // A8-H1: index by (file - rank + 7) in [0..14]
-        for (int i = 0; i < 15; ++i) DIAG_A8H1[i] = 0;
-        for (int r = 0; r < 8; ++r)
-            for (int f = 0; f < 8; ++f)
-                DIAG_A8H1[f - r + 7] |= (1ull << to_sq(f, r));
-    }
 
-    static void build_knight_king()
-    {
-        // Knight moves are (+-1, +-2) and (+-2, +-1)
-        const int kdf[8] = {+1, +2, +2, +1, -1, -2, -2, -1};
-        const int kdr[8] = {+2, +1, -1, -2, -2, -1, +1, +2};
-
-        for (int r = 0; r < 8; ++r)
+        // A line/segment is where the two squares' empty-board rays meet.
+        constexpr SquarePairTable make_square_pairs(bool line)
         {
-            for (int f = 0; f < 8; ++f)
+            BB rook_empty[64]{}, bishop_empty[64]{};
+            for (int s = 0; s < 64; ++s)
             {
-                const int s = to_sq(f, r);
-
-                BB km = 0;
-                for (int i = 0; i < 8; ++i)
-                {
-                    const int nf = f + kdf[i], nr = r + kdr[i];
-                    if (on_board_fr(nf, nr)) km |= (1ull << to_sq(nf, nr));
-                }
-                KNIGHT_ATK[s] = km;
+                rook_empty[s] = rook_rays(s, 0);
+                bishop_empty[s] = bishop_rays(s, 0);
+            }
 
-                // King: all (df, dr) with |df|<=1, |dr|<=1, not (0,0)
-                BB gm = 0;
-                for (int df = -1; df <= 1; ++df)
+            SquarePairTable t{};
+            for (int a = 0; a < 64; ++a)
+            {
+                for (int b = 0; b < 64; ++b)
                 {
-                    for (int dr = -1; dr <= 1; ++dr)
-                    {
-                        if (df == 0 && dr == 0) continue;
-                        const int nf = f + df, nr = r + dr;
-                        if (on_board_fr(nf, nr)) gm |= (1ull << to_sq(nf, nr));
-                    }
+                    if (rook_empty[a] & bit(b))
+                        t[a][b] = line ? (rook_empty[a] & rook_empty[b]) | bit(a) | bit(b)
+                                       : rook_rays(a, bit(b)) & rook_rays(b, bit(a));
+                    else if (bishop_empty[a] & bit(b))
+                        t[a][b] = line ? (bishop_empty[a] & bishop_empty[b]) | bit(a) | bit(b)
+                                       : bishop_rays(a, bit(b)) & bishop_rays(b, bit(a));
                 }
-                KING_ATK[s] = gm;
             }
+            return t;
         }
+    } // namespace
+
+    //=========== Storage for globals declared in the header ===============
+    constexpr SquarePairTable BETWEEN = make_square_pairs(false);
+    constexpr SquarePairTable LINE = make_square_pairs(true);
+
+    Magic ROOK_MAGICS[64];
+    Magic BISHOP_MAGICS[64];
+
+    // Fixed-shift attack tables: one slice of 2^bits entries per square.
+    static BB ROOK_TABLE[64][1 << RookMagicBits];
+    static BB BISHOP_TABLE[64][1 << BishopMagicBits];
+
+    // ================= Magic bitboards ==================
+
+    // Fixed-shift magic multipliers (found offline by a deterministic sparse random
+    // search; shipping them avoids ~100 ms of search at every process start).
+    static constexpr BB ROOK_MAGIC_NUMBERS[64] = {
+        0x1080004008801020ull, 0x0840092002C03000ull, 0x0408080040206400ull, 0x1200020044042009ull,
+        0x0200042008100200ull, 0x0480088004002600ull, 0x20801100D8080882ull, 0x030004420A218100ull,
+        0x12A0800040008020ull, 0x8208404000200010ull, 0x0200500020040130ull, 0x1108200810224C80ull,
+        0x9030008841000810ull, 0x0422800214028008ull, 0x0840300100004081ull, 0x4220081200C20023ull,
+        0x4080000821104000ull, 0x0121A10408824002ull, 0x0001060010205600ull, 0x0010600204091040ull,
+        0x0100220016000402ull, 0x0800408004020041ull, 0x00051004B2100810ull, 0x00122840008015A1ull,
+        0x2800C80090001002ull, 0x0A48916020003814ull, 0x1404388239040004ull, 0x04A0500200060010ull,
+        0x8000100118000840ull, 0x001C00240048D002ull, 0x0042000080420100ull, 0x0000010028009046ull,
+        0x2140401298080040ull, 0x08000C20C0400241ull, 0x008220810010C940ull, 0x28100012001C1808ull,
+        0x0400880004034016ull, 0x0940042801440008ull, 0x0000006116043100ull, 0x5000048005006002ull,
+        0x1281412110200800ull, 0x0008830024010042ull, 0x2000042400801200ull, 0x8220400402442080ull,
+        0x2200022001401400ull, 0x0002001580081010ull, 0x00405102804004E2ull, 0x0430004C10220001ull,
+        0x0100100800A30210ull, 0x4000200140025410ull, 0x1021000884410008ull, 0x04000800043A2008ull,
+        0x0128000900840050ull, 0x0000104008020088ull, 0x4400010002028288ull, 0x80020080013A0040ull,
+        0x000A20C100108001ull, 0x2000202900409112ull, 0x0420000502441209ull, 0x0002081200204002ull,
+        0x1000100A22001582ull, 0x8001815001820006ull, 0x98801290500800A4ull, 0x6090040021004882ull
+    };
+
+    static constexpr BB BISHOP_MAGIC_NUMBERS[64] = {
+        0x000821080409002Aull, 0x210400A02400A000ull, 0x0022004522085900ull, 0x604400520DACC010ull,
+        0x0510806440000400ull, 0x4010602020001000ull, 0x4012100E040600E8ull, 0x0211008840107100ull,
+        0x8204403042420040ull, 0x0804320020E40080ull, 0x000404280020C001ull, 0x0002188040300280ull,
+        0x0020409043840000ull, 0x1004061130240000ull, 0x0004028040404000ull, 0x008000310802048Cull,
+        0x00988280C1080008ull, 0x00E3482000101482ull, 0x0004422021010010ull, 0x0085980044000222ull,
+        0x610208AF01010002ull, 0x12E080C500485200ull, 0x0A12400C494A891Bull, 0x920510000C004400ull,
+        0x0242808244080080ull, 0x0010038288010010ull, 0x0488040400842030ull, 0x008C0240140100A2ull,
+        0x0008840001822000ull, 0x1508044180840088ull, 0x0020908004100800ull, 0x0100200802008212ull,
+        0x0001006221084030ull, 0x0000220800270222ull, 0x0030040222403080ull, 0x4000020080080080ull,
+        0x0028020400011010ull, 0x0000401200010042ull, 0x1086800820060848ull, 0x0462400542000C10ull,
+        0x0A02020201802100ull, 0x410110802C800401ull, 0x0D008200C01000D0ull, 0x5022403200491028ull,
+        0x0060040082014020ull, 0x0002420401000008ull, 0xC00030C252420044ull, 0x0280540440108421ull,
+        0x0000848120050000ull, 0x040334C100402200ull, 0x00700030D0088000ull, 0x200004240C040181ull,
+        0x8004002AC8030004ull, 0x0000400942008800ull, 0x01B1980082000401ull, 0x4008810012420804ull,
+        0x0744B00904201040ull, 0x4102008080452002ull, 0x00A408910208C801ull, 0x1251400640112208ull,
+        0x0400042420090880ull, 0x04C0242051912100ull, 0xD08020049031008Cull, 0x00089082D0440002ull
+    };
+
+    // Index of the most-significant 1 bit (init-time only; b must be non-zero).
+    static inline int msb_slow(BB b)
+    {
+        int i = 63;
+        while (((b >> i) & 1ull) == 0ull) --i;
+        return i;
     }
 
-    //=============== Public helpers ===================
-    BB ray_attacks_from(int sq, Dir dir, BB occ)
+    static BB slider_attacks_slow(int sq, BB occ, const Dir (&dirs)[4])
     {
-        BB attacks = 0;
-        const int step = static_cast<int>(dir);
+        BB atk = 0;
+        for (Dir d : dirs) atk |= ray_attacks_from(sq, d, occ);
+        return atk;
+    }
 
-        // Step outward until edge or blocker; include the blocker square
-        for (int t = sq + step; t >= 0 && t < 64; t += step)
+    // Relevant blocker squares: the full rays minus the last square on each
+    // (an edge square never blocks anything behind it).
+    static BB relevant_mask(int sq, const Dir (&dirs)[4])
+    {
+        BB mask = 0;
+        for (Dir d : dirs)
         {
-            // Prevent wrapping across files for E/W/diagonals
-            if (!step_respects_edge(t - step, t, dir)) break;
-
-            attacks |= bit(t);
-            if (occ & bit(t)) break;
+            const BB ray = ray_attacks_from(sq, d, 0);
+            if (!ray) continue;
+            // The edge square is the farthest one along the ray.
+            const int edge = (static_cast<int>(d) > 0) ? msb_slow(ray) : lsb(ray);
+            mask |= ray & ~bit(edge);
         }
-        return attacks;
+        return mask;
     }
 
-    BB between_mask(int a, int b)
+    static void build_magics(Magic (&magics)[64], BB* table, int bits, const Dir (&dirs)[4], const BB (&numbers)[64])
     {
-        // If not aligned on file, rank, or diagonal, return 0
-        const int af = file_of(a), ar = rank_of(a);
-        const int bf = file_of(b), br = rank_of(b);
+        const int size = 1 << bits;
 
-        const int dfile = bf - af;
-        const int drank = br - ar;
-
-        // Not aligned
-        if (!(af == bf || ar == br || std::abs(dfile) == std::abs(drank)))
-            return 0;
+        for (int sq = 0; sq < 64; ++sq)
+        {
+            Magic& m = magics[sq];
+            BB* slice = table + sq * size;
+            m.mask = relevant_mask(sq, dirs);
+            m.magic = numbers[sq];
+            m.attacks = slice;
+
+            // Fill the entry of every blocker subset of the mask (Carry-Rippler trick)
+            BB sub = 0;
+            do
+            {
+                const BB atk = slider_attacks_slow(sq, sub, dirs);
+                BB& slot = slice[magic_index(m, sub, bits)];
 
-        // Step of -1, 0, or +1 per axis; translate to square delta
-        const int sfile = (dfile > 0) - (dfile < 0);
-        const int srank = (drank > 0) - (drank < 0);
-        const int step = srank * 8 + sfile;
+                // Slider attack sets are never empty, so 0 marks an unused slot. A
+                // mistyped magic shows up as two subsets with different attacks
+                // sharing one slot (the table is zero-initialized static storage).
+                assert((slot == 0 || slot == atk) && "destructive magic collision");
+                slot = atk;
 
-        // Walk from 'a' toward 'b' (exclusive) collecting squares
-        BB mask = 0;
-        for (int t = a + step; t != b; t += step)
-        {
-            // Safety check (should never trip for aligned squares)
-            if (t < 0 || t >= 64) return 0;
-            mask |= bit(t);
+                sub = (sub - m.mask) & m.mask;
+            } while (sub);
         }
-        return mask;
     }
 
-    void init_bitboards()
+    namespace
     {
-        static bool initialized = false;
-        if (initialized) return;
-        initialized = true;
+        // The slider tables are too large to generate at compile time. Filling them
+        // during static initialization (single-threaded, before main) means callers
+        // need no init call and there is nothing to race on.
+        struct SliderTablesInit
+        {
+            SliderTablesInit()
+            {
+                static const Dir rook_dirs[4] = { N, S, E, W };
+                static const Dir bishop_dirs[4] = { NE, NW, SE, SW };
 
-        build_files_ranks();
-        build_diagonals();
-        build_knight_king();
-    }
+                build_magics(ROOK_MAGICS, &ROOK_TABLE[0][0], RookMagicBits, rook_dirs, ROOK_MAGIC_NUMBERS);
+                build_magics(BISHOP_MAGICS, &BISHOP_TABLE[0][0], BishopMagicBits, bishop_dirs, BISHOP_MAGIC_NUMBERS);
+            }
+        } const slider_tables_init;
+    } // namespace
 } // namespace ch
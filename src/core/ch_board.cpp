@@ -1,5 +1,7 @@
 #include "chess/core/ch_board.h"
+#include "chess/core/ch_zobrist.h"
 
+#include <algorithm>
 #include <cstring>
 #include <cctype>
 #include <string>
@@ -54,11 +56,33 @@ namespace ch
             out = v;
             return true;
         }
+
+#ifdef CH_ATTACK_MAPS
+        // Squares a piece attacks from 'sq' (own-occupied squares included)
+        inline BB piece_attacks(Color c, PieceKind k, int sq, BB occ) noexcept
+        {
+            const BB from = bit(sq);
+            switch (k)
+            {
+                case PieceKind::Pawn:
+                    return c == Color::White
+                        ? ((from & ~FILE_MASK[0]) << 7) | ((from & ~FILE_MASK[7]) << 9)
+                        : ((from & ~FILE_MASK[0]) >> 9) | ((from & ~FILE_MASK[7]) >> 7);
+                case PieceKind::Knight: return KNIGHT_ATK[sq];
+                case PieceKind::Bishop: return bishop_attacks(sq, occ);
+                case PieceKind::Rook:   return rook_attacks(sq, occ);
+                case PieceKind::Queen:  return queen_attacks(sq, occ);
+                case PieceKind::King:   return KING_ATK[sq];
+                default:                return 0;
+            }
+        }
+#endif
     } // namespace
 
     void Board::clear()
     {
         std::memset(bb_, 0, sizeof(bb_));
+        std::fill(std::begin(mailbox_), std::end(mailbox_), NoPiece);
         occ_[0] = occ_[1] = 0;
         occ_all_ = 0;
 
@@ -70,6 +94,25 @@ namespace ch
 
         halfmove_clock_ = 0;
         fullmove_number_ = 1;
+
+        key_ = 0; // empty board, White to move, no rights, no EP
+
+#ifdef CH_ATTACK_MAPS
+        attacks_[0] = attacks_[1] = 0;
+        std::memset(attack_count_, 0, sizeof(attack_count_));
+#endif
+    }
+
+    Key Board::compute_key() const noexcept
+    {
+        Key k = 0;
+        for (int sq = 0; sq < 64; ++sq)
+            k ^= ZOBRIST.piece[static_cast<int>(mailbox_[sq])][sq];
+
+        if (stm_ == Color::Black) k ^= ZOBRIST.side;
+        k ^= ZOBRIST.castle[castle_rights_mask()];
+        if (ep_sq_ != -1) k ^= ZOBRIST.ep_file[file_of(ep_sq_)];
+        return k;
     }
 
     void Board::rebuild_occ()
@@ -81,8 +124,91 @@ namespace ch
             occ_[1] |= bb_[1][k];
         }
         occ_all_ = occ_[0] | occ_[1];
+
+#ifdef CH_ATTACK_MAPS
+        rebuild_attacks();
+#endif
+    }
+
+#ifdef CH_ATTACK_MAPS
+    void Board::rebuild_attacks() noexcept
+    {
+        attacks_[0] = attacks_[1] = 0;
+        std::memset(attack_count_, 0, sizeof(attack_count_));
+
+        for (int sq = 0; sq < 64; ++sq)
+        {
+            const Piece pc = mailbox_[sq];
+            if (pc != NoPiece)
+                add_attacks(color_of(pc), piece_attacks(color_of(pc), kind_of(pc), sq, occ_all_));
+        }
+    }
+
+    void Board::add_attacks(Color c, BB set) noexcept
+    {
+        const int ci = static_cast<int>(c);
+        while (set)
+        {
+            const int s = lsb(set); set &= set - 1;
+            if (attack_count_[ci][s]++ == 0) attacks_[ci] |= bit(s);
+        }
+    }
+
+    void Board::sub_attacks(Color c, BB set) noexcept
+    {
+        const int ci = static_cast<int>(c);
+        while (set)
+        {
+            const int s = lsb(set); set &= set - 1;
+            if (--attack_count_[ci][s] == 0) attacks_[ci] &= ~bit(s);
+        }
+    }
+
+    void Board::update_rays_through(int sq, BB occOld) noexcept
+    {
+        // Only sliders that see 'sq' change, and only along the line through it.
+        // A queen seeing sq diagonally has no orthogonal ray through it (and
+        // vice versa), so the bishop/rook part alone gives the whole change.
+        for (int ci = 0; ci < 2; ++ci)
+        {
+            const Color c = static_cast<Color>(ci);
+            const BB queens = bb_[ci][static_cast<int>(PieceKind::Queen)];
+            const BB diag = bb_[ci][static_cast<int>(PieceKind::Bishop)] | queens;
+            const BB orth = bb_[ci][static_cast<int>(PieceKind::Rook)] | queens;
+
+            for (BB pcs = bishop_attacks(sq, occ_all_) & diag; pcs; )
+            {
+                int s = lsb(pcs); pcs ^= bit(s);
+                const BB before = bishop_attacks(s, occOld);
+                const BB after = bishop_attacks(s, occ_all_);
+                sub_attacks(c, before & ~after);
+                add_attacks(c, after & ~before);
+            }
+            for (BB pcs = rook_attacks(sq, occ_all_) & orth; pcs; )
+            {
+                int s = lsb(pcs); pcs ^= bit(s);
+                const BB before = rook_attacks(s, occOld);
+                const BB after = rook_attacks(s, occ_all_);
+                sub_attacks(c, before & ~after);
+                add_attacks(c, after & ~before);
+            }
+        }
     }
 
+    void Board::attacks_after_put(Color c, PieceKind k, int sq) noexcept
+    {
+        update_rays_through(sq, occ_all_ ^ bit(sq));
+        add_attacks(c, piece_attacks(c, k, sq, occ_all_));
+    }
+
+    void Board::attacks_after_remove(Color c, PieceKind k, int sq) noexcept
+    {
+        // A piece's own square never limits its own attacks
+        sub_attacks(c, piece_attacks(c, k, sq, occ_all_));
+        update_rays_through(sq, occ_all_ | bit(sq));
+    }
+#endif
+
     void Board::set_startpos()
     {
         // Standard chess start position FEN.
@@ -119,6 +245,7 @@ namespace ch
 
                 // place piece
                 bb_[static_cast<int>(col)][static_cast<int>(kind)] |= bit(idx(f, r));
+                mailbox_[idx(f, r)] = make_piece(col, kind);
                 ++f;
                 continue;
             }
@@ -189,6 +316,7 @@ namespace ch
             fullmove_number_ = static_cast<std::uint32_t>(fm);
         }
 
+        key_ = compute_key();
         return true;
     }
 
@@ -202,24 +330,11 @@ namespace ch
             int run = 0;
             for (int f = 0; f < 8; ++f)
             {
-                const int sq = idx(f, r);
-                const BB b = bit(sq);
-
-                bool found = false;
-                for (int c = 0; c < 2 && !found; ++c)
-                {
-                    for (int k = 0; k < 6 && !found; ++k)
-                    {
-                        if (bb_[c][k] & b)
-                        {
-                            if (run) { fen.push_back(char('0' + run)); run = 0; }
-                            fen.push_back(kind_to_char(static_cast<PieceKind>(k), static_cast<Color>(c)));
-                            found = true;
-                        }
-                    }
-                }
-
-                if (!found) ++run;
+                const Piece pc = mailbox_[idx(f, r)];
+                if (pc == NoPiece) { ++run; continue; }
+
+                if (run) { fen.push_back(char('0' + run)); run = 0; }
+                fen.push_back(kind_to_char(kind_of(pc), color_of(pc)));
             }
 
             if (run) fen.push_back(char('0' + run));
@@ -259,18 +374,9 @@ namespace ch
 
     void Board::clear_square(int sq)
     {
-        const BB b = bit(sq);
-        for (int c = 0; c < 2; ++c)
-        {
-            for (int k = 0; k < 6; ++k)
-            {
-                if (bb_[c][k] & b)
-                {
-                    bb_[c][k] &= ~b;
-                    rebuild_occ();
-                    return;
-                }
-            }
-        }
+        const Piece pc = mailbox_[sq];
+        if (pc == NoPiece) return;
+
+        clear_piece(color_of(pc), kind_of(pc), sq);
     }
 } // namespace ch
\ No newline at end of file
@@ -1,10 +1,10 @@
 #include "chess/core/ch_state.h"
 #include "chess/core/ch_board.h"
+#include "chess/core/ch_zobrist.h"
 #include "chess/gen/ch_movegen.h"
+#include "chess/analysis/ch_legality.h"
 
 #include <cassert>
-#include <vector>
-#include <algorithm>
 
 #include <iostream>
 
@@ -62,27 +62,6 @@ namespace ch
         return kingSide ? idx(5,r) : idx(3,r);
     }
 
-    // find piece (color, kind) on a square by scanning bitboards
-    static inline bool piece_at(const Board& b, int sq, Color& outC, PieceKind& outK)
-    {
-        const BB mask = bit(sq);
-
-        if (!(b.occ_all() & mask)) return false;
-
-        if (b.occ(Color::White) & mask)
-        {
-            outC = Color::White;
-            for (int k=0; k<6; ++k)
-                if (b.bb(outC, PieceKind(k)) & mask) { outK = PieceKind(k); return true; }
-        }
-        else
-        {
-            outC = Color::Black;
-            for (int k=0; k<6; ++k) if (b.bb(outC, PieceKind(k)) & mask) { outK = PieceKind(k); return true; }
-        }
-        return false;
-    }
-
     // --------------- public API ----------------------
     void make_move(Board& b, Move m, State& st)
     {
@@ -101,15 +80,18 @@ namespace ch
         st.was_ep = false;
         st.was_castle = false;
         st.captured = PieceKind::None;
-        st.moved = PieceKind::None;
+        st.key = b.key();
 
-        // Identify moved piece kind (scan our bitboards at 'from');
-        for (int k = 0; k<6; ++k)
-        {
-            if (b.bb(side, PieceKind(k)) & bit(from)) { st.moved = PieceKind(k); break; }
-        }
+        // Key is updated alongside each change: flip side, drop old EP file;
+        // castling and new EP are folded in at the end.
+        Key key = b.key() ^ ZOBRIST.side;
+        if (st.ep_sq != -1) key ^= ZOBRIST.ep_file[file_of(st.ep_sq)];
+
+        // Identify moved piece kind from the mailbox
+        const Piece moved = b.piece_on(from);
+        st.moved = kind_of(moved);
 
-        assert(st.moved != PieceKind::None && "No moving piece on 'from' for side_to_move");
+        assert(st.moved != PieceKind::None && color_of(moved) == side && "No moving piece on 'from' for side_to_move");
 
         const bool isPawn = (st.moved == PieceKind::Pawn);
         bool didCapture = false;
@@ -119,15 +101,17 @@ namespace ch
             {
                 // En-passant capture: captured pawn sits behind 'to'
                 const int cap_sq = (side==Color::White) ? (to-8) : (to+8);
-                b.clear_piece(them,PieceKind::Pawn,cap_sq);
+                b.remove_piece(them,PieceKind::Pawn,cap_sq);
+                key ^= piece_key(them, PieceKind::Pawn, cap_sq);
                 st.captured = PieceKind::Pawn;
                 st.was_ep = true;
             } else {
                 //Normal capture on 'to'
-                Color c2; PieceKind k2;
-                const bool ok = piece_at(b,to,c2,k2);
-                assert(ok && c2 == them);
-                b.clear_piece(them,k2,to);
+                const Piece victim = b.piece_on(to);
+                assert(victim != NoPiece && color_of(victim) == them);
+                const PieceKind k2 = kind_of(victim);
+                b.remove_piece(them,k2,to);
+                key ^= piece_key(them, k2, to);
                 st.captured = k2;
             }
             didCapture = true;
@@ -142,14 +126,16 @@ namespace ch
             if(is_promotion_dest(side,to))
             {
                 // Promotion: from pawn -> to promoted piece
-                b.clear_piece(side, PieceKind::Pawn, from);
-                b.set_piece(side, promo_code_to_kind(st.promo_code), to);
+                const PieceKind promo = promo_code_to_kind(st.promo_code);
+                b.remove_piece(side, PieceKind::Pawn, from);
+                b.put_piece(side, promo, to);
+                key ^= piece_key(side, PieceKind::Pawn, from) ^ piece_key(side, promo, to);
             }
             else
             {
                 // Normal pawn move
-                b.clear_piece(side, PieceKind::Pawn, from);
-                b.set_piece(side, PieceKind::Pawn, to);
+                b.move_piece(side, PieceKind::Pawn, from, to);
+                key ^= piece_key(side, PieceKind::Pawn, from) ^ piece_key(side, PieceKind::Pawn, to);
 
                 // Double push -> set ep target (square jumped over)
                 if (side == Color::White && rank_of(from) == 1 && rank_of(to) == 3)
@@ -170,30 +156,31 @@ namespace ch
             {
                 st.was_castle = true;
 
-                b.clear_piece(side, PieceKind::King, from);
-                b.set_piece(side, PieceKind::King, to);
+                b.move_piece(side, PieceKind::King, from, to);
 
                 const bool ks = kingSide;
                 const int rf = castle_rook_from(side, ks);
                 const int rt = castle_rook_to(side, ks);
-                b.clear_piece(side, PieceKind::Rook, rf);
-                b.set_piece(side, PieceKind::Rook, rt);
+                b.move_piece(side, PieceKind::Rook, rf, rt);
+
+                key ^= piece_key(side, PieceKind::King, from) ^ piece_key(side, PieceKind::King, to);
+                key ^= piece_key(side, PieceKind::Rook, rf) ^ piece_key(side, PieceKind::Rook, rt);
 
                 clear_castle_for_king(b, side);
             }
             else
             {
                 // Normal king move
-                b.clear_piece(side, PieceKind::King, from);
-                b.set_piece(side, PieceKind::King, to);
+                b.move_piece(side, PieceKind::King, from, to);
+                key ^= piece_key(side, PieceKind::King, from) ^ piece_key(side, PieceKind::King, to);
                 clear_castle_for_king(b,side);
             }
         }
         else
         {
             // Knight / Bishop / Rook / Queen
-            b.clear_piece(side, st.moved, from);
-            b.set_piece(side, st.moved, to);
+            b.move_piece(side, st.moved, from, to);
+            key ^= piece_key(side, st.moved, from) ^ piece_key(side, st.moved, to);
 
             // If a rook moved off its original square, clear that right
             if (st.moved == PieceKind::Rook)
@@ -213,6 +200,13 @@ namespace ch
 
         // Flip side to move
         b.set_side_to_move(them);
+
+        // Fold castling-rights change and new EP file into the key
+        key ^= ZOBRIST.castle[st.castle_mask] ^ ZOBRIST.castle[b.castle_rights_mask()];
+        if (b.ep_target() != -1) key ^= ZOBRIST.ep_file[file_of(b.ep_target())];
+        b.set_key(key);
+
+        assert(b.key() == b.compute_key() && "incremental Zobrist key out of sync");
     }
 
     void unmake_move(Board& b, Move m, const State& st)
@@ -229,31 +223,28 @@ namespace ch
         if (st.moved == PieceKind::King && st.was_castle)
         {
             // Move king back
-            b.clear_piece(side, PieceKind::King, to);
-            b.set_piece(side, PieceKind::King, from);
+            b.move_piece(side, PieceKind::King, to, from);
 
             //Move rook back
             const bool kingSide = (to > from); // e->g is ks, e->c is qs
             const int rf = castle_rook_from(side, kingSide);
             const int rt = castle_rook_to(side,kingSide);
-            b.clear_piece(side,PieceKind::Rook, rt);
-            b.set_piece(side,PieceKind::Rook, rf);
+            b.move_piece(side, PieceKind::Rook, rt, rf);
         }
-        else if (st.moved == PieceKind::Pawn && st.promo_code && is_promotion_dest(side, to))
+        else if (st.moved == PieceKind::Pawn && is_promotion_dest(side, to))
         {
             // Was a promotion: remove promoted piece, restore pawn on from
-            b.clear_piece(side, promo_code_to_kind(st.promo_code),to);
-            b.set_piece(side, PieceKind::Pawn, from);
+            b.remove_piece(side, promo_code_to_kind(st.promo_code),to);
+            b.put_piece(side, PieceKind::Pawn, from);
 
             // Restore captured on 'to' if any
             if (st.captured != PieceKind::None)
-                b.set_piece(them,st.captured, to);
+                b.put_piece(them,st.captured, to);
         }
         else
         {
             // Normal piece move
-            b.clear_piece(side,st.moved,to);
-            b.set_piece(side,st.moved,from);
+            b.move_piece(side, st.moved, to, from);
 
             // Restore if captured piece
             if (st.captured != PieceKind::None)
@@ -261,11 +252,11 @@ namespace ch
                 if (st.was_ep)
                 {
                     const int cap_sq = (side == Color::White) ? (to - 8) : (to + 8);
-                    b.set_piece(them, PieceKind::Pawn, cap_sq);
+                    b.put_piece(them, PieceKind::Pawn, cap_sq);
                 }
                 else
                 {
-                    b.set_piece(them, st.captured, to);
+                    b.put_piece(them, st.captured, to);
                 }
             }
         }
@@ -275,29 +266,18 @@ namespace ch
         b.set_ep_target(st.ep_sq);
         b.set_halfmove_clock(st.halfmove);
         b.set_fullmove_number(st.fullmove);
+        b.set_key(st.key);
+
+        assert(b.key() == b.compute_key() && "restored Zobrist key out of sync");
     }
 
-    // Convenience: validate with movegen, then apply
+    // Convenience: validate the single move (no full generation), then apply
     // Returns true if applied; false if 'm' is not legal in the current position.
     bool apply_if_legal(Board& b, Move m, State& st)
     {
-        std::vector<Move> legal;
-        generate_legal_moves(b,b.side_to_move(),legal);
-
-        auto same = [](const Move& a, const Move& b)
-        {
-            return a.from() == b.from() && a.to() == b.to()
-                && a.is_capture()==b.is_capture()
-                && a.promo_code()==b.promo_code()
-                && a.is_special()==b.is_special();
-        };
-
-        auto it = std::find_if(legal.begin(), legal.end(),
-                                [&](const Move& x) {return same(x,m); });
-
-        if (it == legal.end()) return false;
+        if (!is_pseudo_legal(b, m) || !is_legal(b, m)) return false;
 
-        make_move(b,*it,st);
+        make_move(b,m,st);
         return true;
     }
 
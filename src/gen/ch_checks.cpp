@@ -0,0 +1,211 @@
+#include "chess/gen/ch_checks.h"
+
+#include "chess/core/ch_bitboard.h"
+#include "chess/core/ch_board.h"
+
+#include "chess/analysis/ch_pins.h"
+#include "chess/analysis/ch_legality.h"
+
+#include "chess/gen/ch_legalize.h"
+#include "chess/gen/ch_king_legal.h"
+
+#include "chess/pieces/ch_piece.h"
+#include "chess/pieces/ch_pawn.h"
+
+namespace ch
+{
+    namespace
+    {
+        // Per-position data shared by all moves of one call
+        struct CheckInfo
+        {
+            int ek = -1;       // enemy king square
+            BB occ = 0;        // occupancy before the move
+            BB discover = 0;   // our pieces whose leaving the line to ek uncovers a slider
+            BB sq[6]{};        // squares from which a piece of each kind would attack ek
+        };
+
+        template <Color Us>
+        CheckInfo make_check_info(const Board& b, int ek)
+        {
+            CheckInfo ci;
+            ci.ek = ek;
+            ci.occ = b.occ_all();
+            ci.discover = slider_blockers(b, ek, Us) & b.occ(Us);
+
+            ci.sq[static_cast<int>(PieceKind::Pawn)] = pawn_attacks<opposite(Us)>(bit(ek));
+            ci.sq[static_cast<int>(PieceKind::Knight)] = KNIGHT_ATK[ek];
+            ci.sq[static_cast<int>(PieceKind::Bishop)] = bishop_attacks(ek, ci.occ);
+            ci.sq[static_cast<int>(PieceKind::Rook)] = rook_attacks(ek, ci.occ);
+            ci.sq[static_cast<int>(PieceKind::Queen)] = ci.sq[static_cast<int>(PieceKind::Bishop)]
+                                                      | ci.sq[static_cast<int>(PieceKind::Rook)];
+            return ci;
+        }
+
+        // Destinations of the piece on 'from' that give check (before legality)
+        inline BB checking_targets(const CheckInfo& ci, PieceKind kind, int from)
+        {
+            BB t = ci.sq[static_cast<int>(kind)];
+            if (ci.discover & bit(from)) t |= ~LINE[ci.ek][from];
+            return t;
+        }
+
+        // Does the piece of 'kind' promoted on 'to' (pawn left 'from') attack the enemy king?
+        inline bool promotion_checks(const CheckInfo& ci, PieceKind kind, int from, int to)
+        {
+            const BB occ = ci.occ & ~bit(from);
+            switch (kind)
+            {
+                case PieceKind::Knight: return (KNIGHT_ATK[to] & bit(ci.ek)) != 0;
+                case PieceKind::Bishop: return (bishop_attacks(to, occ) & bit(ci.ek)) != 0;
+                case PieceKind::Rook:   return (rook_attacks(to, occ) & bit(ci.ek)) != 0;
+                case PieceKind::Queen:  return (queen_attacks(to, occ) & bit(ci.ek)) != 0;
+                default: return false;
+            }
+        }
+
+        void push_mask(int from, BB mask, BB enemyOcc, MoveList& out)
+        {
+            for (BB m = mask; m; )
+            {
+                int to = lsb(m); m ^= bit(to);
+                out.push_back(Move::make(from, to, (enemyOcc & bit(to)) != 0));
+            }
+        }
+
+        // Pawn move from -> to (not EP): all checking variants, incl. per-piece promotions
+        template <Color Us>
+        void push_pawn_checks(const CheckInfo& ci, int from, int to, bool capture, MoveList& out)
+        {
+            const bool discovered = (ci.discover & bit(from)) && !(LINE[ci.ek][from] & bit(to));
+            if (bit(to) & PAWN_LAST_RANK<Us>)
+            {
+                for (int code = 0; code < 4; ++code)
+                    if (discovered || promotion_checks(ci, promo_code_to_kind(static_cast<std::uint8_t>(code)), from, to))
+                        out.push_back(Move::make(from, to, capture, code));
+            }
+            else if (discovered || (ci.sq[static_cast<int>(PieceKind::Pawn)] & bit(to)))
+                out.push_back(Move::make(from, to, capture));
+        }
+
+        template <Color Us>
+        void push_pawn_set(const CheckInfo& ci, BB targets, int delta, bool capture, MoveList& out)
+        {
+            for (BB m = targets; m; )
+            {
+                int to = lsb(m); m ^= bit(to);
+                push_pawn_checks<Us>(ci, to - delta, to, capture, out);
+            }
+        }
+
+        template <Color Us>
+        void generate_checks(const Board& b, MoveList& out)
+        {
+            constexpr Color them = opposite(Us);
+            out.clear();
+
+            const BB ekbb = b.bb(them, PieceKind::King);
+            const BB kbb = b.bb(Us, PieceKind::King);
+            if (!ekbb || !kbb) return;
+
+            const CheckInfo ci = make_check_info<Us>(b, lsb(ekbb));
+            const Pins pins = compute_pins(b, Us);
+            const CheckState cs = compute_check_state(pins);
+            const BB enemyOcc = b.occ(them);
+            const int ks = lsb(kbb);
+
+            // --- King: discovered checks and castling ---
+            {
+                const BB legal = legal_king_moves<Us>(b);
+                constexpr int r = (Us == Color::White) ? 0 : 7;
+                const BB castles = (ks == idx(4, r)) ? (legal & (bit(idx(6, r)) | bit(idx(2, r)))) : 0;
+
+                if (ci.discover & bit(ks))
+                    push_mask(ks, legal & ~castles & ~LINE[ci.ek][ks], enemyOcc, out);
+
+                for (BB c = castles; c; )
+                {
+                    const int to = lsb(c); c ^= bit(to);
+                    const bool ksSide = (to > ks);
+                    const int rt = ksSide ? idx(5, r) : idx(3, r);
+                    const int rf = ksSide ? idx(7, r) : idx(0, r);
+                    // Exact: rook landing with check, or the king uncovering a slider
+                    const BB occ = (ci.occ & ~bit(ks) & ~bit(rf)) | bit(to) | bit(rt);
+                    const BB queens = b.bb(Us, PieceKind::Queen);
+                    const BB rooks = (b.bb(Us, PieceKind::Rook) & ~bit(rf)) | bit(rt);
+                    if ((rook_attacks(ci.ek, occ) & (rooks | queens))
+                        || (bishop_attacks(ci.ek, occ) & (b.bb(Us, PieceKind::Bishop) | queens)))
+                        out.push_back(Move::make(ks, to, false, 0, /*special*/ true));
+                }
+            }
+
+            if (cs.double_check) return;
+
+            MoveOpts opts;
+
+            // --- Pieces: legal destinations restricted to checking squares ---
+            auto gen_piece = [&](auto tag, PieceKind kind)
+            {
+                for (BB pcs = b.bb(Us, kind); pcs; )
+                {
+                    int s = lsb(pcs); pcs ^= bit(s);
+                    BB pseudo = move(tag, Us, s, b, MovePhase::All, opts) & checking_targets(ci, kind, s);
+                    if (!pseudo) continue;
+                    push_mask(s, legalize_nonking_mask<Us>(b, pseudo, s, kind, pins, cs), enemyOcc, out);
+                }
+            };
+            gen_piece(Knight, PieceKind::Knight);
+            gen_piece(Bishop, PieceKind::Bishop);
+            gen_piece(Rook, PieceKind::Rook);
+            gen_piece(Queen, PieceKind::Queen);
+
+            // --- Unpinned pawns (set-wise legal destinations) ---
+            const PawnMoveSets ps = legal_pawn_sets<Us>(b, pins, cs);
+            push_pawn_set<Us>(ci, ps.push1, pawn_push_delta<Us>(), false, out);
+            push_pawn_set<Us>(ci, ps.push2, 2 * pawn_push_delta<Us>(), false, out);
+            push_pawn_set<Us>(ci, ps.cap_west, pawn_west_delta<Us>(), true, out);
+            push_pawn_set<Us>(ci, ps.cap_east, pawn_east_delta<Us>(), true, out);
+
+            // --- Pinned pawns ---
+            opts.ep_sq = b.ep_target();
+            BB epFrom = ps.ep_from;
+            for (BB pcs = b.bb(Us, PieceKind::Pawn) & pins.pinned; pcs; )
+            {
+                int s = lsb(pcs); pcs ^= bit(s);
+                BB pseudo = move<Us>(Pawn, s, b, MovePhase::All, opts);
+                BB legal = legalize_nonking_mask<Us>(b, pseudo, s, PieceKind::Pawn, pins, cs);
+                if (b.ep_target() != -1 && (legal & bit(b.ep_target())))
+                {
+                    epFrom |= bit(s);
+                    legal &= ~bit(b.ep_target());
+                }
+                for (BB m = legal; m; )
+                {
+                    int to = lsb(m); m ^= bit(to);
+                    push_pawn_checks<Us>(ci, s, to, (enemyOcc & bit(to)) != 0, out);
+                }
+            }
+
+            // --- En-passant: exact test on the post-capture occupancy ---
+            for (BB f = epFrom; f; )
+            {
+                const int s = lsb(f); f ^= bit(s);
+                const int to = b.ep_target();
+                const int cap = to - pawn_push_delta<Us>();
+                const BB occ = (ci.occ & ~bit(s) & ~bit(cap)) | bit(to);
+                const BB queens = b.bb(Us, PieceKind::Queen);
+                const bool check = (ci.sq[static_cast<int>(PieceKind::Pawn)] & bit(to))
+                    || (bishop_attacks(ci.ek, occ) & (b.bb(Us, PieceKind::Bishop) | queens))
+                    || (rook_attacks(ci.ek, occ) & (b.bb(Us, PieceKind::Rook) | queens));
+                if (check)
+                    out.push_back(Move::make(s, to, /*capture*/true, /*promo*/ 0, /*special*/ true));
+            }
+        }
+    } // namespace
+
+    void generate_legal_checks(const Board& b, Color side, MoveList& out)
+    {
+        if (side == Color::White) generate_checks<Color::White>(b, out);
+        else                      generate_checks<Color::Black>(b, out);
+    }
+} // namespace ch
@@ -6,46 +6,32 @@
 
 namespace ch
 {
-    static inline int king_home_square(Color side) noexcept
+    template <Color Us>
+    BB legal_king_moves(const Board& b)
     {
-        const int r = (side == Color::White) ? 0 : 7;
-        return idx(4, r); // e1/e8
-    }
-
-    static inline bool rook_on_square(const Board& b, Color side, int sq) noexcept
-    {
-        return (b.bb(side, PieceKind::Rook) & bit(sq)) != 0;
-    }
+        constexpr Color them = opposite(Us);
+        constexpr int r = (Us == Color::White) ? 0 : 7;
 
-    BB legal_king_moves(const Board& b, Color side)
-    {
-        const Color them = opposite(side);
-
-        const BB kbb = b.bb(side, PieceKind::King);
+        const BB kbb = b.bb(Us, PieceKind::King);
         if (!kbb) return 0;
 
         const int ks = lsb(kbb);
 
         // 1) Normal king steps (geometry), excluding own-occupied.
-        BB moves = KING_ATK[ks] & ~b.occ(side);
+        BB moves = KING_ATK[ks] & ~b.occ(Us);
 
         // 2) Filter out squares attacked by the opponent.
+        //    The king is lifted from the occupancy so a slider checking along a
+        //    line still covers the square behind the king. A piece captured on
+        //    'to' never attacks its own square, so it needs no special handling.
+        const BB occ = b.occ_all() & ~kbb;
         BB legal = 0;
         for (BB m = moves; m; )
         {
             const int to = lsb(m);
             m ^= bit(to);
 
-            Board tmp = b;
-
-            // If king captures something on 'to', remove it
-            tmp.clear_square(to);
-
-            // Move king
-            tmp.clear_piece(side, PieceKind::King, ks);
-            tmp.set_piece(side, PieceKind::King, to);
-
-            if (!is_attacked(tmp, to, them))
+            if (!attackers_to<them>(b, to, occ))
                 legal |= bit(to);
         }
 
@@ -60,32 +46,31 @@ namespace ch
         //
         // We add destination square (g1/c1 or g8/c8) to the returned mask if legal.
 
-        if (ks == king_home_square(side) && !is_attacked(b, ks, them))
+        const BB occAll = b.occ_all();
+        if (ks == idx(4, r) && !attackers_to<them>(b, ks, occAll)) // e1/e8, not in check
         {
-            const int r = (side == Color::White) ? 0 : 7;
-
             // King-side: e -> g, rook h -> f
-            if (b.castle_k(side))
+            if (b.castle_k(Us))
             {
                 const int f = idx(5, r);
                 const int g = idx(6, r);
                 const int h = idx(7, r);
 
                 const BB empty_needed = bit(f) | bit(g);
-                const bool empty_ok = (b.occ_all() & empty_needed) == 0;
+                const bool empty_ok = (occAll & empty_needed) == 0;
 
-                const bool rook_ok = rook_on_square(b, side, h);
+                const bool rook_ok = (b.bb(Us, PieceKind::Rook) & bit(h)) != 0;
 
                 if (empty_ok && rook_ok)
                 {
                     // Squares king traverses: f and g must not be attacked
-                    if (!is_attacked(b, f, them) && !is_attacked(b, g, them))
+                    if (!attackers_to<them>(b, f, occAll) && !attackers_to<them>(b, g, occAll))
                         legal |= bit(g);
                 }
             }
 
             // Queen-side: e -> c, rook a -> d
-            if (b.castle_q(side))
+            if (b.castle_q(Us))
             {
                 const int d = idx(3, r);
                 const int c = idx(2, r);
@@ -94,14 +79,14 @@ namespace ch
 
                 // Between squares must be empty: d, c, b
                 const BB empty_needed = bit(d) | bit(c) | bit(bq);
-                const bool empty_ok = (b.occ_all() & empty_needed) == 0;
+                const bool empty_ok = (occAll & empty_needed) == 0;
 
-                const bool rook_ok = rook_on_square(b, side, a);
+                const bool rook_ok = (b.bb(Us, PieceKind::Rook) & bit(a)) != 0;
 
                 if (empty_ok && rook_ok)
                 {
                     // Squares king traverses: d and c must not be attacked
-                    if (!is_attacked(b, d, them) && !is_attacked(b, c, them))
+                    if (!attackers_to<them>(b, d, occAll) && !attackers_to<them>(b, c, occAll))
                         legal |= bit(c);
                 }
             }
@@ -109,4 +94,12 @@ namespace ch
 
         return legal;
     }
-} // namespace ch
\ No newline at end of file
+
+    template BB legal_king_moves<Color::White>(const Board&);
+    template BB legal_king_moves<Color::Black>(const Board&);
+
+    BB legal_king_moves(const Board& b, Color side)
+    {
+        return side == Color::White ? legal_king_moves<Color::White>(b) : legal_king_moves<Color::Black>(b);
+    }
+} // namespace ch
@@ -10,6 +10,7 @@
 #include "chess/gen/ch_king_legal.h"
 
 #include "chess/pieces/ch_piece.h"
+#include "chess/pieces/ch_pawn.h"
 
 namespace ch
 {
@@ -19,7 +20,7 @@ namespace ch
 
         // Precompute context
         Pins pins = compute_pins(b, side);
-        CheckState cs = compute_check_state(b, side);
+        CheckState cs = compute_check_state(pins);
 
         MoveOpts opts;
         opts.ep_sq = b.ep_target();
@@ -69,8 +70,29 @@ namespace ch
             out.per_square[s] = legalize_nonking_mask(b, pseudo, s, PieceKind::Queen, side, pins, cs);
         }
 
-        // Pawns
-        for (BB pcs = b.bb(side, PieceKind::Pawn); pcs; )
+        // Pawns: unpinned ones set-wise, destinations mapped back to their origin
+        const PawnMoveSets ps = legal_pawn_sets(b, side, pins, cs);
+        const int up = pawn_push_delta(side);
+        auto scatter = [&out](BB targets, int delta)
+        {
+            for (BB m = targets; m; )
+            {
+                int to = lsb(m); m ^= bit(to);
+                out.per_square[to - delta] |= bit(to);
+            }
+        };
+        scatter(ps.push1, up);
+        scatter(ps.push2, 2 * up);
+        scatter(ps.cap_west, pawn_west_delta(side));
+        scatter(ps.cap_east, pawn_east_delta(side));
+        for (BB f = ps.ep_from; f; )
+        {
+            int s = lsb(f); f ^= bit(s);
+            out.per_square[s] |= bit(b.ep_target());
+        }
+
+        // Pinned pawns
+        for (BB pcs = b.bb(side, PieceKind::Pawn) & pins.pinned; pcs; )
         {
             int s = lsb(pcs); pcs ^= bit(s);
             BB pseudo = move(Pawn, side, s, b, MovePhase::All, opts);
@@ -2,31 +2,22 @@
 
 #include "chess/core/ch_board.h"
 #include "chess/core/ch_bitboard.h"
+#include "chess/pieces/ch_pawn.h"
+#include "chess/analysis/ch_attack.h"
 
 namespace ch
 {
-    static inline BB white_pawns_attacking_to(int sq)
-    {
-        BB t = bit(sq);
-        return ((t >> 7) & ~FILE_MASK[0]) | ((t >> 9) & ~FILE_MASK[7]);
-    }
-
-    static inline BB black_pawns_attacking_to(int sq)
-    {
-        BB t = bit(sq);
-        return ((t << 9) & ~FILE_MASK[0]) | ((t << 7) & ~FILE_MASK[7]);
-    }
-
     // EP legality: check king safety after EP capture using modified occupancy.
-    static bool king_safe_after_ep(const Board& b, Color side, int fromSq, int ep_to)
+    template <Color Us>
+    static bool king_safe_after_ep(const Board& b, int fromSq, int ep_to)
     {
-        const Color them = opposite(side);
-        BB kbb = b.bb(side, PieceKind::King);
+        constexpr Color them = opposite(Us);
+        BB kbb = b.bb(Us, PieceKind::King);
         if (!kbb) return false;
         int ks = lsb(kbb);
 
         // Captured pawn square is behind EP target
-        const int cap_sq = (side == Color::White) ? (ep_to - 8) : (ep_to + 8);
+        const int cap_sq = ep_to - pawn_push_delta<Us>();
 
         // Build occupancy after EP (without mutating the board):
         BB occ = b.occ_all();
@@ -34,48 +25,25 @@ namespace ch
         occ &= ~bit(cap_sq); // captured pawn dissappears
         occ |= bit(ep_to); // our pawn lands on ep_to
 
-        // Enemy pawns without the captured pawn
-        BB e_pawns = b.bb(them, PieceKind::Pawn) & ~bit(cap_sq);
-
-        // Check attacks on our king using the modified occupancy:
-        BB attackers = 0;
-        attackers |= KNIGHT_ATK[ks] & b.bb(them, PieceKind::Knight);
-        attackers |= KING_ATK[ks] & b.bb(them,PieceKind::King);
-
-        if (them == Color::White) attackers |= white_pawns_attacking_to(ks) & e_pawns;
-        else                      attackers |= black_pawns_attacking_to(ks) & e_pawns;
-
-        // sliders using modified occupancy
-        BB bishops = b.bb(them, PieceKind::Bishop);
-        BB rooks = b.bb(them, PieceKind::Rook);
-        BB queens = b.bb(them, PieceKind::Queen);
-
-        BB diag = ray_attacks_from(ks, NE, occ) | ray_attacks_from(ks, NW, occ)
-                | ray_attacks_from(ks, SE, occ) | ray_attacks_from(ks, SW, occ);
-        BB ortho = ray_attacks_from(ks, N, occ) | ray_attacks_from(ks, S, occ)
-                 | ray_attacks_from(ks, E, occ) | ray_attacks_from(ks, W, occ);
-
-        attackers |= diag & (bishops | queens);
-        attackers |= ortho& (rooks | queens);
-
-        return attackers == 0;
+        // Attacks on our king with the modified occupancy; the captured pawn no longer attacks
+        return (attackers_to<them>(b, ks, occ) & ~bit(cap_sq)) == 0;
     }
 
+    template <Color Us>
     BB legalize_nonking_mask(const Board& b,
                              BB pseudo,
                              int fromSq,
                              PieceKind kind,
-                             Color side,
                              const Pins& pins,
                              const CheckState& cs)
     {
         // 1) Double check: only the king can move
         if (cs.double_check) return 0;
 
-        // 2) If pinned, the piece may move along the closed king<->pinner segment
+        // 2) If pinned, the piece may only move along the king<->pinner line
         if (pins.pinned & bit(fromSq))
         {
-            pseudo &= pins.ray_to_enemy[fromSq];
+            pseudo &= pins.line(fromSq);
         }
 
         // 3) If in single check, non-king moves must block or capture the checker
@@ -83,7 +51,17 @@ namespace ch
         //      block_mask = between(king, checker) U {checker}
         if (cs.in_check)
         {
-            pseudo &= cs.block_mask;
+            BB allowed = cs.block_mask;
+
+            // An EP capture removes a checking pawn without landing on its square
+            const int ep = b.ep_target();
+            if (kind == PieceKind::Pawn && ep != -1)
+            {
+                const int cap_sq = ep - pawn_push_delta<Us>();
+                if (cap_sq == cs.checker_sq) allowed |= bit(ep);
+            }
+
+            pseudo &= allowed;
         }
 
         // EP: keep it only if the king remains after EP
@@ -95,7 +73,7 @@ namespace ch
                 BB epb = bit(ep);
                 if (pseudo & epb)
                 {
-                    if (!king_safe_after_ep(b, side, fromSq, ep))
+                    if (!king_safe_after_ep<Us>(b, fromSq, ep))
                         pseudo &= ~epb;
                 }
             }
@@ -103,4 +81,62 @@ namespace ch
 
         return pseudo;
     }
-} // namespace ch
\ No newline at end of file
+
+    template <Color Us>
+    PawnMoveSets legal_pawn_sets(const Board& b, const Pins& pins, const CheckState& cs)
+    {
+        constexpr Color them = opposite(Us);
+
+        PawnMoveSets out{};
+        if (cs.double_check) return out;
+
+        const BB pawns = b.bb(Us, PieceKind::Pawn) & ~pins.pinned;
+        const BB empty = ~b.occ_all();
+        const BB enemy = b.occ(them);
+        const BB target = cs.in_check ? cs.block_mask : ~BB{0};
+
+        // Double pushes need the unrestricted single-push set (the skipped square only has to be empty)
+        const BB single = pawn_single_pushes<Us>(pawns, empty);
+        out.push1 = single & target;
+        out.push2 = pawn_double_pushes<Us>(single, empty) & target;
+        out.cap_west = pawn_attacks_west<Us>(pawns) & enemy & target;
+        out.cap_east = pawn_attacks_east<Us>(pawns) & enemy & target;
+
+        // EP is rare and has its own king-safety rule: per pawn
+        const int ep = b.ep_target();
+        if (ep != -1)
+        {
+            const BB epb = bit(ep);
+            for (BB c = pawns & pawn_attacks<them>(epb); c; )
+            {
+                const int from = lsb(c); c ^= bit(from);
+                if (legalize_nonking_mask<Us>(b, epb, from, PieceKind::Pawn, pins, cs))
+                    out.ep_from |= bit(from);
+            }
+        }
+        return out;
+    }
+
+    template BB legalize_nonking_mask<Color::White>(const Board&, BB, int, PieceKind, const Pins&, const CheckState&);
+    template BB legalize_nonking_mask<Color::Black>(const Board&, BB, int, PieceKind, const Pins&, const CheckState&);
+    template PawnMoveSets legal_pawn_sets<Color::White>(const Board&, const Pins&, const CheckState&);
+    template PawnMoveSets legal_pawn_sets<Color::Black>(const Board&, const Pins&, const CheckState&);
+
+    BB legalize_nonking_mask(const Board& b,
+                             BB pseudo,
+                             int fromSq,
+                             PieceKind kind,
+                             Color side,
+                             const Pins& pins,
+                             const CheckState& cs)
+    {
+        return side == Color::White ? legalize_nonking_mask<Color::White>(b, pseudo, fromSq, kind, pins, cs)
+                                    : legalize_nonking_mask<Color::Black>(b, pseudo, fromSq, kind, pins, cs);
+    }
+
+    PawnMoveSets legal_pawn_sets(const Board& b, Color side, const Pins& pins, const CheckState& cs)
+    {
+        return side == Color::White ? legal_pawn_sets<Color::White>(b, pins, cs)
+                                    : legal_pawn_sets<Color::Black>(b, pins, cs);
+    }
+} // namespace ch
@@ -1,38 +1,18 @@
 #include "chess/gen/ch_movegen.h"
+#include "chess/gen/ch_movegen_detail.h"
 
 #include "chess/core/ch_bitboard.h"
 #include "chess/core/ch_board.h"
 
-#include "chess/analysis/ch_pins.h"
-#include "chess/analysis/ch_legality.h"
-
-#include "chess/gen/ch_legalize.h"
-#include "chess/gen/ch_king_legal.h"
-
 #include "chess/pieces/ch_piece.h"
-
-#include <cassert>
+#include "chess/pieces/ch_pawn.h"
 
 namespace ch
 {
-    static inline void push_moves_from_mask(int from, BB mask, bool is_capture_mask, std::vector<Move>& out)
-    {
-        for (BB m = mask; m; )
-        {
-            int to = lsb(m);
-            m ^= bit(to);
-            out.push_back(Move::make(from, to, is_capture_mask));
-        }
-    }
-
-    // Emit 4 promotion moves for a single (from, to) pawn move
-    static inline void push_promotions(int from, int to, bool capture, std::vector<Move>& out)
-    {
-        out.push_back(Move::make(from, to, capture, 0));
-        out.push_back(Move::make(from, to, capture, 1));
-        out.push_back(Move::make(from, to, capture, 2));
-        out.push_back(Move::make(from, to, capture, 3));
-    }
+    using detail::push_moves_from_mask;
+    using detail::push_pawn_moves;
+    using detail::push_pawn_promotions;
+    using detail::GenStage;
 
     static inline bool on_last_rank(Color side, int sq)
     {
@@ -40,155 +20,186 @@ namespace ch
         return side == Color::White ? (r == 7) : (r == 0);
     }
 
-    static inline bool is_castle_to(Color side, int from, int to)
+    // Clears and fills a move container with one stage of the shared generator
+    template <GenStage S, class List>
+    static inline void generate_legal_dispatch(const Board& b, Color side, List& out)
     {
-        // Require king to start on e-file (e1, e8)
-        int r = (side == Color::White) ? 0 : 7;
-        int e = (r << 3) | 4;
-        int g = (r << 3) | 6;
-        int c = (r << 3) | 2;
-        return (from == e) && (to == g || to == c);
+        out.clear();
+        detail::PushSink<List> sink{ out };
+        detail::generate_legal_for<S>(b, side, sink);
     }
 
     void generate_legal_moves(const Board& b, Color side, std::vector<Move>& out)
     {
-        out.clear();
+        generate_legal_dispatch<GenStage::All>(b, side, out);
+    }
 
-        // Precompute context for non-king pieces
-        Pins pins = compute_pins(b, side);
-        CheckState cs = compute_check_state(b, side);
+    void generate_legal_moves(const Board& b, Color side, MoveList& out)
+    {
+        generate_legal_dispatch<GenStage::All>(b, side, out);
+    }
 
-        MoveOpts opts; // default: no explicit castle shaping; we add castle seperately
-        opts.ep_sq = b.ep_target();
+    int count_legal_moves(const Board& b, Color side)
+    {
+        detail::CountSink sink;
+        detail::generate_legal_for<GenStage::All>(b, side, sink);
+        return sink.n;
+    }
+
+    void generate_pseudo_legal_moves(const Board& b, Color side, MoveList& out)
+    {
+        out.clear();
 
         const Color them = opposite(side);
-        BB enemyOcc = b.occ(them);
+        const BB own = b.occ(side);
+        const BB enemyOcc = b.occ(them);
+        const BB empty = ~b.occ_all();
 
-        //--- King (with castling legality) ---
+        // --- King: steps + castling by rights and empty path only ---
+        if (BB kbb = b.bb(side, PieceKind::King))
         {
-            BB kbb = b.bb(side, PieceKind::King);
-            if (kbb)
+            const int ks = lsb(kbb);
+            BB steps = KING_ATK[ks] & ~own;
+            push_moves_from_mask(ks, steps & ~enemyOcc, false, out);
+            push_moves_from_mask(ks, steps & enemyOcc, true, out);
+
+            const int r = (side == Color::White) ? 0 : 7;
+            if (ks == idx(4, r))
             {
-                int ks = lsb(kbb);
-                
-                // legal_king_moves() already:
-                //  - excludes stepping onto attacked squares
-                //  - excludes own-occupied squares
-                //  - includes castling destinations if legal
-                BB ksteps = legal_king_moves(b, side);
-
-                for (BB m = ksteps; m; )
-                {
-                    int to =  lsb(m);
-                    m^= bit(to);
-
-                    bool is_cap = (enemyOcc & bit(to)) != 0;
-                    bool special = is_castle_to(side, ks, to); // mark castle for make/unmake
-                    out.push_back(Move::make(ks, to, is_cap, 0, special));
-                }
+                const BB rooks = b.bb(side, PieceKind::Rook);
+                if (b.castle_k(side) && (rooks & bit(idx(7, r)))
+                    && (b.occ_all() & (bit(idx(5, r)) | bit(idx(6, r)))) == 0)
+                    out.push_back(Move::make(ks, idx(6, r), false, 0, /*special*/ true));
+                if (b.castle_q(side) && (rooks & bit(idx(0, r)))
+                    && (b.occ_all() & (bit(idx(1, r)) | bit(idx(2, r)) | bit(idx(3, r)))) == 0)
+                    out.push_back(Move::make(ks, idx(2, r), false, 0, /*special*/ true));
             }
         }
-        
-        // Double check: only king moves are legal
-        if(cs.double_check) return;
-
-        // --- Knights ---
-        for (BB pcs = b.bb(side, PieceKind::Knight); pcs; )
-        {
-            int s = lsb(pcs); pcs ^= bit(s);
-            BB pseudo = move(Knight, side, s, b, MovePhase::All, opts);
-            BB legal = legalize_nonking_mask(b, pseudo, s, PieceKind::Knight, side, pins, cs);
-
-            BB cap = legal & enemyOcc;
-            BB qui = legal & ~enemyOcc;
-            push_moves_from_mask(s, qui, false, out);
-            push_moves_from_mask(s, cap, true, out);
-        }
 
-        // --- Bishops ---
-        for (BB pcs = b.bb(side, PieceKind::Bishop); pcs; )
+        // --- Pieces ---
+        auto gen_piece = [&](auto tag, PieceKind kind)
         {
-            int s = lsb(pcs); pcs ^= bit(s);
-            BB pseudo = move(Bishop, side, s, b, MovePhase::All, opts);
-            BB legal = legalize_nonking_mask(b, pseudo, s, PieceKind::Bishop, side, pins, cs);
-            BB cap = legal & enemyOcc;
-            BB qui = legal & ~enemyOcc;
-            push_moves_from_mask(s, qui, false, out);
-            push_moves_from_mask(s, cap, true, out);
-        }
-
-        // --- Rooks ---
-        for (BB pcs = b.bb(side, PieceKind::Rook); pcs; )
+            MoveOpts opts;
+            for (BB pcs = b.bb(side, kind); pcs; )
+            {
+                int s = lsb(pcs); pcs ^= bit(s);
+                BB dest = move(tag, side, s, b, MovePhase::All, opts);
+                push_moves_from_mask(s, dest & ~enemyOcc, false, out);
+                push_moves_from_mask(s, dest & enemyOcc, true, out);
+            }
+        };
+        gen_piece(Knight, PieceKind::Knight);
+        gen_piece(Bishop, PieceKind::Bishop);
+        gen_piece(Rook, PieceKind::Rook);
+        gen_piece(Queen, PieceKind::Queen);
+
+        // --- Pawns (set-wise) ---
+        const BB pawns = b.bb(side, PieceKind::Pawn);
+        const BB lastRank = RANK_MASK[side == Color::White ? 7 : 0];
+        const int up = pawn_push_delta(side);
+
+        const BB push1 = pawn_single_pushes(side, pawns, empty);
+        const BB push2 = pawn_double_pushes(side, push1, empty);
+        const BB capW = pawn_attacks_west(side, pawns) & enemyOcc;
+        const BB capE = pawn_attacks_east(side, pawns) & enemyOcc;
+
+        push_pawn_moves(push1 & ~lastRank, up, false, out);
+        push_pawn_moves(push2, 2 * up, false, out);
+        push_pawn_promotions(push1 & lastRank, up, false, out);
+        push_pawn_moves(capW & ~lastRank, pawn_west_delta(side), true, out);
+        push_pawn_moves(capE & ~lastRank, pawn_east_delta(side), true, out);
+        push_pawn_promotions(capW & lastRank, pawn_west_delta(side), true, out);
+        push_pawn_promotions(capE & lastRank, pawn_east_delta(side), true, out);
+
+        if (const int ep = b.ep_target(); ep != -1)
         {
-            int s = lsb(pcs); pcs ^= bit(s);
-            BB pseudo = move(Rook, side, s, b, MovePhase::All, opts);
-            BB legal = legalize_nonking_mask(b, pseudo, s, PieceKind::Rook, side, pins, cs);
-
-            BB cap = legal & enemyOcc;
-            BB qui = legal & ~enemyOcc;
-            push_moves_from_mask(s, qui, false, out);
-            push_moves_from_mask(s, cap, true, out);
+            const BB epb = bit(ep);
+            for (BB f = pawns & (pawn_attacks_west(them, epb) | pawn_attacks_east(them, epb)); f; )
+            {
+                int s = lsb(f); f ^= bit(s);
+                out.push_back(Move::make(s, ep, /*capture*/true, /*promo*/ 0, /*special*/ true));
+            }
         }
+    }
 
-        // --- Queens ---
-        for (BB pcs = b.bb(side, PieceKind::Queen); pcs; )
-        {
-            int s = lsb(pcs); pcs ^= bit(s);
-            BB pseudo = move(Queen, side, s, b, MovePhase::All, opts);
-            BB legal = legalize_nonking_mask(b, pseudo, s, PieceKind::Queen, side, pins, cs);
-
-            BB cap = legal & enemyOcc;
-            BB qui = legal & ~enemyOcc;
-            push_moves_from_mask(s, qui, false, out);
-            push_moves_from_mask(s, cap, true, out);
-        }
+    bool is_pseudo_legal(const Board& b, Move m)
+    {
+        const Color side = b.side_to_move();
+        const Color them = opposite(side);
+        const int from = m.from();
+        const int to = m.to();
 
-        // --- Pawns ---
-        for (BB pcs = b.bb(side, PieceKind::Pawn); pcs; )
-        {
-            int s = lsb(pcs); pcs ^= bit(s);
-            BB pseudo = move(Pawn, side, s, b, MovePhase::All, opts);
-            BB legal = legalize_nonking_mask(b, pseudo, s, PieceKind::Pawn, side, pins, cs);
+        const Piece pc = b.piece_on(from);
+        if (pc == NoPiece || color_of(pc) != side) return false;
+        if (b.occ(side) & bit(to)) return false;
 
-            const int ep = b.ep_target();
-            const bool has_ep = (ep != -1);
+        const PieceKind kind = kind_of(pc);
+        const bool enemyOnTo = (b.occ(them) & bit(to)) != 0;
+        const BB occ = b.occ_all();
 
-            BB cap = legal & enemyOcc;
-            BB qui = legal & ~enemyOcc;
+        // Promotion code is only meaningful for pawns reaching the last rank
+        const bool promoting = (kind == PieceKind::Pawn) && on_last_rank(side, to);
+        if (!promoting && m.promo_code() != 0) return false;
 
-            // Promotions: if destination is last rank, emit 4 promotions instead of a normal pawn move.
-            for (BB q = qui; q; )
+        if (m.is_special())
+        {
+            if (kind == PieceKind::Pawn)
             {
-                int to = lsb(q); q ^= bit(to);
-                const bool is_ep = has_ep && (to == ep);
-                if (is_ep)
-                {
-                    // En-passent: capture + special
-                    out.push_back(Move::make(s,to,/*capture*/true, /*promo*/ 0, /*special*/ true));
-                    continue;
-                }
-                if (on_last_rank(side, to))
-                    push_promotions(s, to, /*capture*/false, out);
-                else
-                    out.push_back(Move::make(s, to, /*capture*/false));
+                // En-passant
+                const BB from_bb = bit(from);
+                return to == b.ep_target() && m.is_capture()
+                    && ((pawn_attacks_west(side, from_bb) | pawn_attacks_east(side, from_bb)) & bit(to));
             }
+            if (kind != PieceKind::King || m.is_capture()) return false;
+
+            // Castling: same conditions as the pseudo-legal generator
+            const int r = (side == Color::White) ? 0 : 7;
+            if (from != idx(4, r)) return false;
+            const BB rooks = b.bb(side, PieceKind::Rook);
+            if (to == idx(6, r))
+                return b.castle_k(side) && (rooks & bit(idx(7, r)))
+                    && (occ & (bit(idx(5, r)) | bit(idx(6, r)))) == 0;
+            if (to == idx(2, r))
+                return b.castle_q(side) && (rooks & bit(idx(0, r)))
+                    && (occ & (bit(idx(1, r)) | bit(idx(2, r)) | bit(idx(3, r)))) == 0;
+            return false;
+        }
+
+        if (m.is_capture() != enemyOnTo) return false;
 
-            for (BB c = cap; c; )
+        switch (kind)
+        {
+            case PieceKind::Pawn:
             {
-                int to = lsb(c); c ^= bit(to);
-                if (on_last_rank(side, to))
-                    push_promotions(s, to, /*capture*/true, out);
-                else
-                    out.push_back(Move::make(s, to, /*capture*/true));
-            }
+                const BB from_bb = bit(from);
+                if (m.is_capture())
+                    return ((pawn_attacks_west(side, from_bb) | pawn_attacks_east(side, from_bb)) & bit(to)) != 0;
 
-            // NOTE: en-passant moves are already included in `legal` if:
-            //  - pseudo included EP target (via move(Pawn,...,MovePhase::All, opts))
-            //  - legalize_nonking_mask kept it (king_safe_after_ep)
-            //
-            // Those EP moves will appear either in `cap` or `qui` depending on how pawn move()
-            // encodes them. In your current design, EP is treated as a "capture" at the mask level,
-            // and make_move checks (pawn && capture && special) to detect EP.
+                const BB one = pawn_single_pushes(side, from_bb, ~occ);
+                const BB two = pawn_double_pushes(side, one, ~occ);
+                return ((one | two) & bit(to)) != 0;
+            }
+            case PieceKind::Knight: return (KNIGHT_ATK[from] & bit(to)) != 0;
+            case PieceKind::Bishop: return (bishop_attacks(from, occ) & bit(to)) != 0;
+            case PieceKind::Rook:   return (rook_attacks(from, occ) & bit(to)) != 0;
+            case PieceKind::Queen:  return (queen_attacks(from, occ) & bit(to)) != 0;
+            case PieceKind::King:   return (KING_ATK[from] & bit(to)) != 0;
+            default: return false;
         }
     }
-} // namespace ch
\ No newline at end of file
+
+    void generate_legal_captures(const Board& b, Color side, MoveList& out)
+    {
+        generate_legal_dispatch<GenStage::Captures>(b, side, out);
+    }
+
+    void generate_legal_quiets(const Board& b, Color side, MoveList& out)
+    {
+        generate_legal_dispatch<GenStage::Quiets>(b, side, out);
+    }
+
+    void generate_legal_evasions(const Board& b, Color side, MoveList& out)
+    {
+        generate_legal_dispatch<GenStage::Evasions>(b, side, out);
+    }
+} // namespace ch
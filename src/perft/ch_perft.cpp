@@ -0,0 +1,223 @@
+#include "chess/perft/ch_perft.h"
+
+#include "chess/core/ch_board.h"
+#include "chess/core/ch_state.h"
+#include "chess/gen/ch_movegen.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+
+namespace ch
+{
+    std::uint64_t perft(Board& b, int depth)
+    {
+        if (depth <= 0) return 1;
+
+        // Bulk counting: leaves are the legal moves themselves
+        if (depth == 1) return static_cast<std::uint64_t>(count_legal_moves(b, b.side_to_move()));
+
+        MoveList moves;
+        generate_legal_moves(b, b.side_to_move(), moves);
+
+        std::uint64_t nodes = 0;
+        for (Move m : moves)
+        {
+            State st;
+            make_move(b, m, st);
+            nodes += perft(b, depth - 1);
+            unmake_move(b, m, st);
+        }
+        return nodes;
+    }
+
+    // ---------------- hashed perft ----------------
+    PerftHashTable::PerftHashTable(std::size_t megabytes)
+    {
+        const std::size_t want = std::max<std::size_t>(1, megabytes * 1024 * 1024 / sizeof(Entry));
+        std::size_t n = 1;
+        while (n * 2 <= want) n *= 2;
+
+        table_ = std::make_unique<Entry[]>(n);
+        mask_ = n - 1;
+    }
+
+    namespace
+    {
+        // Spreads the depth over all key bits, so (key, depth) pairs only alias
+        // as often as two random keys would
+        constexpr std::uint64_t depth_salt(int depth) noexcept
+        {
+            return static_cast<std::uint64_t>(depth) * 0x9E3779B97F4A7C15ull;
+        }
+    } // namespace
+
+    bool PerftHashTable::probe(Key key, int depth, std::uint64_t& nodes) const noexcept
+    {
+        const Entry& e = table_[key & mask_];
+        const std::uint64_t n = e.nodes.load(std::memory_order_relaxed);
+        const std::uint64_t check = e.check.load(std::memory_order_relaxed);
+
+        if ((check ^ n) != (key ^ depth_salt(depth))) return false;
+
+        nodes = n;
+        return true;
+    }
+
+    void PerftHashTable::store(Key key, int depth, std::uint64_t nodes) noexcept
+    {
+        Entry& e = table_[key & mask_];
+        e.check.store(key ^ depth_salt(depth) ^ nodes, std::memory_order_relaxed);
+        e.nodes.store(nodes, std::memory_order_relaxed);
+    }
+
+    void PerftHashTable::clear() noexcept
+    {
+        for (std::size_t i = 0; i <= mask_; ++i)
+        {
+            table_[i].check.store(0, std::memory_order_relaxed);
+            table_[i].nodes.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    std::uint64_t perft_hashed(Board& b, int depth, PerftHashTable& tt)
+    {
+        if (depth <= 0) return 1;
+
+        std::uint64_t nodes = 0;
+        if (depth > 1 && tt.probe(b.key(), depth, nodes)) return nodes;
+
+        if (depth == 1) return static_cast<std::uint64_t>(count_legal_moves(b, b.side_to_move()));
+
+        MoveList moves;
+        generate_legal_moves(b, b.side_to_move(), moves);
+
+        for (Move m : moves)
+        {
+            State st;
+            make_move(b, m, st);
+            nodes += perft_hashed(b, depth - 1, tt);
+            unmake_move(b, m, st);
+        }
+
+        tt.store(b.key(), depth, nodes);
+        return nodes;
+    }
+
+    std::vector<PerftDivideEntry> perft_divide(Board& b, int depth)
+    {
+        std::vector<PerftDivideEntry> out;
+        if (depth <= 0) return out;
+
+        MoveList moves;
+        generate_legal_moves(b, b.side_to_move(), moves);
+        out.reserve(moves.size());
+
+        for (Move m : moves)
+        {
+            State st;
+            make_move(b, m, st);
+            out.push_back({ m, perft(b, depth - 1) });
+            unmake_move(b, m, st);
+        }
+        return out;
+    }
+
+    namespace
+    {
+        // Subtree waiting to be searched: position after the split moves,
+        // remaining depth and the root move it is credited to.
+        struct PerftTask
+        {
+            Board board;
+            int depth = 0;
+            std::size_t root = 0;
+        };
+
+        // Enough subtrees that uneven root moves still balance across workers
+        constexpr std::size_t TasksPerThread = 16;
+
+        void expand_tasks(std::vector<PerftTask>& tasks)
+        {
+            std::vector<PerftTask> next;
+            MoveList moves;
+            for (PerftTask& t : tasks)
+            {
+                moves.clear();
+                generate_legal_moves(t.board, t.board.side_to_move(), moves);
+                for (Move m : moves)
+                {
+                    PerftTask child{ t.board, t.depth - 1, t.root };
+                    State st;
+                    make_move(child.board, m, st);
+                    next.push_back(std::move(child));
+                }
+            }
+            tasks.swap(next);
+        }
+    } // namespace
+
+    PerftParallelResult perft_divide_parallel(const Board& b, int depth, int threads, PerftHashTable* tt)
+    {
+        PerftParallelResult res;
+        if (depth <= 0) return res;
+
+        if (threads <= 0) threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+        // Root split
+        Board root = b;
+        MoveList moves;
+        generate_legal_moves(root, root.side_to_move(), moves);
+
+        std::vector<PerftTask> tasks;
+        tasks.reserve(moves.size());
+        for (std::size_t i = 0; i < moves.size(); ++i)
+        {
+            PerftTask t{ root, depth - 1, i };
+            State st;
+            make_move(t.board, moves[i], st);
+            tasks.push_back(std::move(t));
+        }
+
+        // Split deeper while there is too little work to go around; keep at
+        // least one ply per task so every task still bulk-counts its leaves.
+        const std::size_t wanted = static_cast<std::size_t>(threads) * TasksPerThread;
+        while (!tasks.empty() && tasks.size() < wanted && tasks.front().depth > 1)
+            expand_tasks(tasks);
+
+        res.divide.resize(moves.size());
+        for (std::size_t i = 0; i < moves.size(); ++i) res.divide[i].move = moves[i];
+        res.threads.resize(static_cast<std::size_t>(threads));
+
+        std::vector<std::atomic<std::uint64_t>> root_nodes(moves.size());
+        std::atomic<std::size_t> next{ 0 };
+        const auto t0 = std::chrono::steady_clock::now();
+
+        auto worker = [&](PerftThreadStats& stats)
+        {
+            for (std::size_t i = next.fetch_add(1, std::memory_order_relaxed); i < tasks.size();
+                 i = next.fetch_add(1, std::memory_order_relaxed))
+            {
+                PerftTask& t = tasks[i];
+                const std::uint64_t n = tt ? perft_hashed(t.board, t.depth, *tt) : perft(t.board, t.depth);
+                root_nodes[t.root].fetch_add(n, std::memory_order_relaxed);
+                stats.nodes += n;
+                ++stats.tasks;
+            }
+            stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+        };
+
+        std::vector<std::thread> pool;
+        pool.reserve(res.threads.size() - 1);
+        for (std::size_t i = 1; i < res.threads.size(); ++i)
+            pool.emplace_back(worker, std::ref(res.threads[i]));
+        worker(res.threads[0]); // calling thread is worker 0
+        for (std::thread& th : pool) th.join();
+
+        for (std::size_t i = 0; i < moves.size(); ++i)
+            res.divide[i].nodes = root_nodes[i].load(std::memory_order_relaxed);
+        return res;
+    }
+} // namespace ch
@@ -1,12 +1,58 @@
 #include "chess/core/ch_board.h"
 #include "chess/analysis/ch_attack.h"
+#include "chess/analysis/ch_see.h"
 #include "chess/core/ch_square.h"
+#ifdef CH_ATTACK_MAPS
+#include "chess/core/ch_movelist.h"
+#include "chess/core/ch_state.h"
+#include "chess/gen/ch_movegen.h"
+#endif
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 
+#ifdef CH_ATTACK_MAPS
+// Incremental maps against a from-scratch computation: attack_info() and
+// attackers_to() never read the maps, attacks_side() does.
+static void check_attack_maps(const ch::Board& b)
+{
+    for (ch::Color c : { ch::Color::White, ch::Color::Black })
+    {
+        const ch::BB fresh = ch::attack_info(b, c).all;
+        assert(b.attack_map(c) == fresh);
+        assert(ch::attacks_side(b, c) == (fresh & ~b.occ(c)));
+        for (int sq = 0; sq < 64; ++sq)
+            assert(b.attacker_count(c, sq) == ch::popcount(ch::attackers_to(b, sq, c)));
+    }
+}
+
+// Perft walk that checks the maps at every node and after every unmake
+static std::uint64_t walk_attack_maps(ch::Board& b, int depth)
+{
+    check_attack_maps(b);
+    if (depth == 0) return 1;
+
+    ch::MoveList moves;
+    ch::generate_legal_moves(b, b.side_to_move(), moves);
+
+    std::uint64_t nodes = 0;
+    for (ch::Move m : moves)
+    {
+        const ch::BB before[2] = { b.attack_map(ch::Color::White), b.attack_map(ch::Color::Black) };
+
+        ch::State st;
+        ch::make_move(b, m, st);
+        nodes += walk_attack_maps(b, depth - 1);
+        ch::unmake_move(b, m, st);
+
+        assert(b.attack_map(ch::Color::White) == before[0] && b.attack_map(ch::Color::Black) == before[1]);
+    }
+    return nodes;
+}
+#endif
+
 int main()
 {
-    ch::init_bitboards();
     ch::Board b;
 
     b.set_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
@@ -22,6 +68,19 @@ int main()
         assert((nAtt & ch::bit(ch::sq_from_str("e2"))) == 0);
     }
 
+    // 1b) Pawns control both diagonals whether or not an enemy stands there. The
+    //     old move()-based path only returned occupied enemy squares and the EP
+    //     square, so none of these matched before (a2 and d5 gave 0, e5 only d6).
+    b.set_fen("4k3/8/8/3pP3/8/8/P7/4K3 w - d6 0 1");
+    {
+        auto sq = [](const char* s) { return ch::bit(ch::sq_from_str(s)); };
+        assert(ch::attacks_from(b, ch::Color::White, ch::PieceKind::Pawn, ch::sq_from_str("a2")) == sq("b3"));
+        // e5: d6 is the EP square but f6 is empty and still controlled
+        assert(ch::attacks_from(b, ch::Color::White, ch::PieceKind::Pawn, ch::sq_from_str("e5")) == (sq("d6") | sq("f6")));
+        // d5 (black): e4 and c4 are empty
+        assert(ch::attacks_from(b, ch::Color::Black, ch::PieceKind::Pawn, ch::sq_from_str("d5")) == (sq("c4") | sq("e4")));
+    }
+
     // 2) Side attacks: from startpos, black attacks include e4 (by d5 pawn after push? not yet) but d4 is attacked by c5 pawn? No.
     // Simpler: white attacks should include b5 from a4 knight? Let's alter a simple custom position:
     b.set_fen("8/8/8/8/2B5/8/8/4K3 w - - 0 1");
@@ -33,6 +92,110 @@ int main()
         assert((wAll & ch::bit(ch::sq_from_str("d1"))) != 0);
     }
 
+    // 3) Per-kind breakdown and double attacks from the start position
+    b.set_fen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1");
+    {
+        ch::AttackInfo ai = ch::attack_info(b, ch::Color::White);
+        ch::BB pawnAtk = ai.by_kind[static_cast<int>(ch::PieceKind::Pawn)];
+        assert(pawnAtk == ch::RANK_MASK[2]);
+        assert((ai.twice & ch::bit(ch::sq_from_str("f3"))) != 0); // e2, g2, Ng1
+        assert((ai.twice & ch::bit(ch::sq_from_str("a3"))) != 0); // b2, Nb1
+        assert((ai.twice & ch::RANK_MASK[3]) == 0);
+        // Own pieces are "defended" in AttackInfo but not controlled in attacks_side
+        assert((ai.all & ch::bit(ch::sq_from_str("e2"))) != 0);
+        assert(ch::attacks_side(b, ch::Color::White) == (ai.all & ~b.occ(ch::Color::White)));
+    }
+
+    // 4) SEE: pawn takes a defended knight wins knight minus pawn
+    b.set_fen("4k3/8/3p4/4n3/3P4/8/8/4K3 w - - 0 1");
+    {
+        ch::Move pxn = ch::Move::make(ch::sq_from_str("d4"), ch::sq_from_str("e5"), true);
+        assert(ch::see(b, pxn) == ch::SEE_VALUE[1] - ch::SEE_VALUE[0]);
+        assert(ch::see_ge(b, pxn, 0));
+        assert(ch::see_ge(b, pxn, 220));
+        assert(!ch::see_ge(b, pxn, 221));
+    }
+
+    // 5) SEE x-ray: the rook behind on the d-file backs up Rxd5 (without it, -400)
+    b.set_fen("3rk3/8/8/3p4/8/8/3R4/3RK3 w - - 0 1");
+    {
+        ch::Move rxp = ch::Move::make(ch::sq_from_str("d2"), ch::sq_from_str("d5"), true);
+        assert(ch::see(b, rxp) == ch::SEE_VALUE[0]);
+        assert(ch::see_ge(b, rxp, 100));
+        assert(!ch::see_ge(b, rxp, 101));
+
+        // Both-color attackers; the d1 rook only shows up once d2 is vacated
+        int d5 = ch::sq_from_str("d5");
+        ch::BB both = ch::bit(ch::sq_from_str("d2")) | ch::bit(ch::sq_from_str("d8"));
+        assert(ch::attackers_to(b, d5, b.occ_all()) == both);
+        ch::BB occ = b.occ_all() & ~ch::bit(ch::sq_from_str("d2"));
+        assert((ch::attackers_to(b, d5, occ) & occ) == (ch::bit(ch::sq_from_str("d1")) | ch::bit(ch::sq_from_str("d8"))));
+
+        b.set_fen("3rk3/8/8/3p4/8/8/3R4/4K3 w - - 0 1");
+        assert(ch::see(b, rxp) == ch::SEE_VALUE[0] - ch::SEE_VALUE[3]);
+        assert(!ch::see_ge(b, rxp, 0));
+    }
+
+    // 5b) SEE x-ray through a queen behind a rook: Qd1 backs up Rxd5 against one
+    //     defender, but must not recapture into a second one
+    b.set_fen("3rk3/8/8/3p4/8/8/3R4/3QK3 w - - 0 1");
+    {
+        ch::Move rxp = ch::Move::make(ch::sq_from_str("d2"), ch::sq_from_str("d5"), true);
+        assert(ch::see(b, rxp) == ch::SEE_VALUE[0]);
+        assert(ch::see_ge(b, rxp, 100));
+        assert(!ch::see_ge(b, rxp, 101));
+
+        int d5 = ch::sq_from_str("d5");
+        ch::BB occ = b.occ_all() & ~ch::bit(ch::sq_from_str("d2"));
+        assert((ch::slider_attackers_to(b, d5, occ) & occ) == (ch::bit(ch::sq_from_str("d1")) | ch::bit(ch::sq_from_str("d8"))));
+
+        b.set_fen("3rk3/3r4/8/3p4/8/8/3R4/3QK3 w - - 0 1");
+        assert(ch::see(b, rxp) == ch::SEE_VALUE[0] - ch::SEE_VALUE[3]);
+        assert(ch::see_ge(b, rxp, -400));
+        assert(!ch::see_ge(b, rxp, -399));
+    }
+
+    // 5c) Both-color attackers_to() with leapers: each side's pawns attack forward
+    //     only, and the result is the union of the single-color queries
+    b.set_fen("7k/5n2/3pp3/8/2NPP3/8/8/K7 w - - 0 1");
+    {
+        int e5 = ch::sq_from_str("e5");
+        ch::BB expect = ch::bit(ch::sq_from_str("d4")) | ch::bit(ch::sq_from_str("c4"))
+                      | ch::bit(ch::sq_from_str("d6")) | ch::bit(ch::sq_from_str("f7"));
+        assert(ch::attackers_to(b, e5, b.occ_all()) == expect);
+        assert(expect == (ch::attackers_to(b, e5, ch::Color::White) | ch::attackers_to(b, e5, ch::Color::Black)));
+        assert(ch::slider_attackers_to(b, e5, b.occ_all()) == 0);
+    }
+
+#ifdef CH_ATTACK_MAPS
+    // 6) Incremental maps survive make/unmake and match a fresh computation at every
+    //    node of a perft walk (node counts double-check that generation is unaffected)
+    {
+        struct WalkCase
+        {
+            const char* fen;
+            int depth;
+            std::uint64_t nodes;
+        };
+
+        const WalkCase cases[] = {
+            { "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 3, 8902 },
+            { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862 },
+            { "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 3, 2812 },
+            { "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3, 9467 },
+        };
+
+        for (const WalkCase& c : cases)
+        {
+            b.set_fen(c.fen);
+            assert(walk_attack_maps(b, c.depth) == c.nodes);
+        }
+
+        b.set_fen("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1");
+        assert(b.attacker_count(ch::Color::White, ch::sq_from_str("f3")) == 3); // g2, Be2, Ne5
+    }
+#endif
+
     std::cout << "attack maps OK\n";
     return 0;
 }
\ No newline at end of file
@@ -5,13 +5,15 @@
 #include "chess/core/ch_square.h"
 #include "chess/gen/ch_legalize.h"
 #include "chess/gen/ch_movegen.h"
+#include "chess/gen/ch_checks.h"
+#include "chess/analysis/ch_legality.h"
+#include "chess/core/ch_state.h"
 #include <cassert>
 #include <iostream>
 
 int main()
 {
     using namespace ch;
-    init_bitboards();
 
     Board b;
     b.set_startpos();
@@ -21,6 +23,11 @@ int main()
     std::cout << "white legal moves: " << mv.size() << "\n";
     assert(mv.size() == 20);
 
+    int visited = 0;
+    const bool visitedAll = for_each_legal_move(b, Color::White, [&](Move) { ++visited; });
+    assert(visitedAll && visited == 20);
+    assert(has_legal_move(b, Color::White));
+
     // Check case: Ke1, Nf3 vs ...Bb4+ -> only Nf3-d2 plus king moves if legal
     b.clear();
     b.set_piece(Color::White, PieceKind::King,   sq_from_str("e1"));
@@ -36,6 +43,85 @@ int main()
             foundNf3d2 = true;
     }
     assert(foundNf3d2);
+
+    // MoveList overload yields the same moves in the same order
+    MoveList ml;
+    generate_legal_moves(b, Color::White, ml);
+    assert(ml.size() == mv.size());
+    for (std::size_t i = 0; i < ml.size(); ++i) assert(ml[i] == mv[i]);
+
+    // Staged generators: in check the evasions are the full move list,
+    // and captures + quiets always partition it
+    MoveList ev, caps, quiets;
+    generate_legal_evasions(b, Color::White, ev);
+    generate_legal_captures(b, Color::White, caps);
+    generate_legal_quiets(b, Color::White, quiets);
+    assert(ev.size() == mv.size());
+    assert(caps.size() + quiets.size() == mv.size());
+    assert(count_legal_moves(b, Color::White) == static_cast<int>(mv.size()));
+
+    // Pseudo-legal generation + is_legal filter gives the same set
+    MoveList pseudo;
+    generate_pseudo_legal_moves(b, Color::White, pseudo);
+    std::size_t nlegal = 0;
+    for (Move m : pseudo) nlegal += is_legal(b, m) ? 1 : 0;
+    assert(pseudo.size() > mv.size() && nlegal == mv.size());
+    assert(!is_legal(b, Move::make(sq_from_str("f3"), sq_from_str("e5"))));
+    assert(is_pseudo_legal(b, Move::make(sq_from_str("f3"), sq_from_str("e5"))));
+    assert(!is_pseudo_legal(b, Move::make(sq_from_str("f3"), sq_from_str("f5"))));
+    assert(!is_pseudo_legal(b, Move::make(sq_from_str("f3"), sq_from_str("d2"), /*capture*/true)));
+    // Set-wise pins: Be2 pinned by Re8, checkers empty; a knight check shows up in checkers
+    b.clear();
+    b.set_piece(Color::White, PieceKind::King,   sq_from_str("e1"));
+    b.set_piece(Color::White, PieceKind::Bishop, sq_from_str("e2"));
+    b.set_piece(Color::Black, PieceKind::Rook,   sq_from_str("e8"));
+    b.set_piece(Color::Black, PieceKind::Knight, sq_from_str("d3"));
+    {
+        const Pins p = compute_pins(b, Color::White);
+        assert(p.pinned == bit(sq_from_str("e2")));
+        assert(p.line(sq_from_str("e2")) == FILE_MASK[4]);
+        assert(p.checkers == bit(sq_from_str("d3")));
+
+        // Check state derived from the pins matches the direct computation
+        const CheckState cs = compute_check_state(p);
+        const CheckState direct = compute_check_state(b, Color::White);
+        assert(cs.in_check && !cs.double_check);
+        assert(cs.checker_sq == direct.checker_sq && cs.block_mask == direct.block_mask);
+    }
+
+    // King may not step back along the checking ray (it must not shield e3 from the rook)
+    b.clear();
+    b.set_piece(Color::White, PieceKind::King, sq_from_str("e4"));
+    b.set_piece(Color::Black, PieceKind::Rook, sq_from_str("e8"));
+    b.set_piece(Color::Black, PieceKind::King, sq_from_str("a8"));
+    const BB km = legal_king_moves(b, Color::White);
+    assert(!(km & bit(sq_from_str("e3"))) && !(km & bit(sq_from_str("e5"))));
+    assert(km & bit(sq_from_str("d3")));
+
+    // apply_if_legal: rejects an illegal move, plays a legal one
+    {
+        Board sp; sp.set_startpos();
+        State st;
+        const bool illegalPlayed = apply_if_legal(sp, Move::make(sq_from_str("e2"), sq_from_str("e5")), st);
+        assert(!illegalPlayed);
+        const bool legalPlayed = apply_if_legal(sp, Move::make(sq_from_str("e2"), sq_from_str("e4")), st);
+        assert(legalPlayed);
+        assert(sp.side_to_move() == Color::Black && sp.ep_target() == sq_from_str("e3"));
+    }
+
+    // Check generator: castling with a rook check, plus the direct rook checks
+    {
+        Board cb;
+        const bool ok = cb.set_fen("5k2/8/8/8/8/8/8/4K2R w K - 0 1");
+        assert(ok);
+        MoveList checks;
+        generate_legal_checks(cb, Color::White, checks);
+        bool castleCheck = false;
+        for (Move m : checks)
+            castleCheck |= (m.from() == sq_from_str("e1") && m.to() == sq_from_str("g1") && m.is_special());
+        assert(castleCheck && checks.size() == 3); // O-O, Rf1+, Rh8+
+    }
+
     std::cout << "movegen smoke ok\n";
     
     return 0;
@@ -2,6 +2,7 @@
 #include "chess/core/ch_board.h"
 #include "chess/core/ch_square.h"
 #include "chess/pieces/ch_piece.h"
+#include "chess/pieces/ch_pawn.h"
 #include <cassert>
 #include <iostream>
 
@@ -20,7 +21,6 @@ static void print_bb(ch::BB b)
 
 int main()
 {
-    ch::init_bitboards();
     ch::Board b;
     b.clear(); // empty board
 
@@ -29,6 +29,11 @@ int main()
     b.set_piece(ch::Color::White, ch::PieceKind::Bishop, ch::sq_from_str("c1"));
     b.set_piece(ch::Color::Black, ch::PieceKind::Pawn, ch::sq_from_str("e5"));
 
+    // Mailbox mirrors the bitboards
+    assert(b.piece_on(ch::sq_from_str("d4")) == ch::make_piece(ch::Color::White, ch::PieceKind::Knight));
+    assert(ch::kind_of(b.piece_on(ch::sq_from_str("e5"))) == ch::PieceKind::Pawn);
+    assert(b.piece_on(ch::sq_from_str("e4")) == ch::NoPiece);
+
     ch::MoveOpts o; // defaults
 
     // Knight attacks from d4 on empty board
@@ -48,6 +53,47 @@ int main()
         assert(quiet & ch::bit(ch::sq_from_str("a3")));
     }
 
+    // Magic slider lookups must agree with the reference ray walk
+    {
+        const ch::BB occ = b.occ_all();
+        for (int sq = 0; sq < 64; ++sq)
+        {
+            const ch::BB rook = ch::ray_attacks_from(sq, ch::N, occ) | ch::ray_attacks_from(sq, ch::S, occ)
+                              | ch::ray_attacks_from(sq, ch::E, occ) | ch::ray_attacks_from(sq, ch::W, occ);
+            const ch::BB bishop = ch::ray_attacks_from(sq, ch::NE, occ) | ch::ray_attacks_from(sq, ch::NW, occ)
+                                | ch::ray_attacks_from(sq, ch::SE, occ) | ch::ray_attacks_from(sq, ch::SW, occ);
+            assert(ch::rook_attacks(sq, occ) == rook);
+            assert(ch::bishop_attacks(sq, occ) == bishop);
+        }
+    }
+
+    // Square-pair tables
+    {
+        const int a1 = ch::sq_from_str("a1"), d4 = ch::sq_from_str("d4"), h8 = ch::sq_from_str("h8");
+        const int e1 = ch::sq_from_str("e1"), e8 = ch::sq_from_str("e8"), b3 = ch::sq_from_str("b3");
+        assert(ch::popcount(ch::BETWEEN[a1][h8]) == 6);
+        assert(ch::BETWEEN[e1][e8] == (ch::FILE_MASK[4] & ~ch::RANK_MASK[0] & ~ch::RANK_MASK[7]));
+        assert(ch::BETWEEN[a1][b3] == 0 && ch::LINE[a1][b3] == 0);
+        assert(ch::aligned(a1, d4, h8) && !ch::aligned(a1, d4, e1));
+        assert(ch::LINE[e1][ch::sq_from_str("e4")] == ch::FILE_MASK[4]);
+    }
+
+    // Set-wise pawn moves agree with the per-pawn masks in the start position
+    {
+        ch::Board sp; sp.set_startpos();
+        const ch::BB empty = ~sp.occ_all();
+        for (ch::Color c : { ch::Color::White, ch::Color::Black })
+        {
+            const ch::BB one = ch::pawn_single_pushes(c, sp.bb(c, ch::PieceKind::Pawn), empty);
+            const ch::BB two = ch::pawn_double_pushes(c, one, empty);
+            assert(one == ch::RANK_MASK[c == ch::Color::White ? 2 : 5]);
+            assert(two == ch::RANK_MASK[c == ch::Color::White ? 3 : 4]);
+        }
+        const ch::BB h2 = ch::bit(ch::sq_from_str("h2"));
+        assert(ch::pawn_attacks_east(ch::Color::White, h2) == 0);
+        assert(ch::pawn_attacks_west(ch::Color::White, h2) == ch::bit(ch::sq_from_str("g3")));
+    }
+
     std::cout << "All piece-masks smoke tests passed. \n";
     return 0;
 }
\ No newline at end of file
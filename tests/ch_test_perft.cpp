@@ -0,0 +1,254 @@
+#include "chess/analysis/ch_attack.h"
+#include "chess/core/ch_board.h"
+#include "chess/core/ch_state.h"
+#include "chess/core/ch_square.h"
+#include "chess/gen/ch_checks.h"
+#include "chess/gen/ch_movegen.h"
+#include "chess/perft/ch_perft.h"
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <iostream>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+// Bitboards, not just the mailbox: to_fen() alone would miss stale bitboard bits
+static bool same_pieces(const ch::Board& a, const ch::Board& b)
+{
+    for (ch::Color c : { ch::Color::White, ch::Color::Black })
+        for (int k = 0; k < 6; ++k)
+            if (a.bb(c, static_cast<ch::PieceKind>(k)) != b.bb(c, static_cast<ch::PieceKind>(k)))
+                return false;
+    return a.occ_all() == b.occ_all() && a.to_fen() == b.to_fen();
+}
+
+// Kinds of checking move seen by walk_checks(), so the test can insist on each
+struct CheckKinds
+{
+    std::uint64_t direct = 0, discovered = 0, promotion = 0, en_passant = 0, castling = 0;
+};
+
+// At every node of a perft walk, generate_legal_checks() must return exactly the
+// legal moves after which make_move() leaves the opponent in check
+static void walk_checks(ch::Board& b, int depth, CheckKinds& seen)
+{
+    const ch::Color us = b.side_to_move();
+    ch::MoveList moves, checks;
+    ch::generate_legal_moves(b, us, moves);
+    ch::generate_legal_checks(b, us, checks);
+
+    std::vector<std::uint16_t> expect, got;
+    for (ch::Move m : checks) got.push_back(m.v);
+
+    for (ch::Move m : moves)
+    {
+        const ch::PieceKind moved = ch::kind_of(b.piece_on(m.from()));
+        const int toRank = m.to() / 8;
+
+        ch::State st;
+        ch::make_move(b, m, st);
+        const ch::Color them = b.side_to_move();
+        if (ch::in_check(b, them))
+        {
+            expect.push_back(m.v);
+
+            const int ksq = ch::lsb(b.bb(them, ch::PieceKind::King));
+            const ch::BB checkers = ch::attackers_to(b, ksq, us);
+            if (moved == ch::PieceKind::King && m.is_special()) ++seen.castling;
+            else if (moved == ch::PieceKind::Pawn && m.is_special()) ++seen.en_passant;
+            else if (moved == ch::PieceKind::Pawn && (toRank == 0 || toRank == 7)) ++seen.promotion;
+            else if (checkers & ~ch::bit(m.to())) ++seen.discovered;
+            else ++seen.direct;
+        }
+        if (depth > 1) walk_checks(b, depth - 1, seen);
+        ch::unmake_move(b, m, st);
+    }
+
+    std::sort(expect.begin(), expect.end());
+    std::sort(got.begin(), got.end());
+    if (expect != got)
+        std::cout << "check generator mismatch: " << b.to_fen() << "\n";
+    assert(expect == got);
+}
+
+int main()
+{
+    ch::Board b;
+
+    // Knight promotion (promo code 0) must unmake back to the pawn, capture restored
+    b.set_fen("1r5k/P7/8/8/8/8/8/7K w - - 0 1");
+    {
+        const ch::Board before = b;
+
+        for (ch::Move m : { ch::Move::make(ch::sq_from_str("a7"), ch::sq_from_str("a8"), false, 0),
+                            ch::Move::make(ch::sq_from_str("a7"), ch::sq_from_str("b8"), true, 0) })
+        {
+            ch::State st;
+            ch::make_move(b, m, st);
+            assert(ch::kind_of(b.piece_on(m.to())) == ch::PieceKind::Knight);
+            ch::unmake_move(b, m, st);
+            assert(same_pieces(b, before));
+            assert(b.key() == before.key());
+        }
+    }
+
+    // d2-d4+ checks the c5 king; exd3 e.p. removes the checker without landing on d4
+    b.set_fen("8/8/8/2k5/3Pp3/8/8/4K3 b - d3 0 1");
+    {
+        std::vector<ch::Move> moves;
+        ch::generate_legal_moves(b, ch::Color::Black, moves);
+
+        bool foundEp = false;
+        for (ch::Move m : moves)
+            if (m.from() == ch::sq_from_str("e4") && m.to() == ch::sq_from_str("d3") && m.is_special())
+                foundEp = true;
+        assert(foundEp);
+    }
+
+    // Standard reference positions at shallow depth (full values: chessprogramming.org "Perft Results")
+    {
+        struct PerftCase
+        {
+            const char* fen;
+            int depth;
+            std::uint64_t nodes;
+        };
+
+        const PerftCase cases[] = {
+            { "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 4, 197281 },
+            { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3, 97862 },
+            { "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4, 43238 },
+            { "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3, 9467 },
+            { "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3, 62379 },
+        };
+
+        for (const PerftCase& c : cases)
+        {
+            const bool parsed = b.set_fen(c.fen);
+            assert(parsed);
+            const std::uint64_t n = ch::perft(b, c.depth);
+            if (n != c.nodes)
+                std::cout << "perft mismatch: " << c.fen << " d" << c.depth << " = " << n << "\n";
+            assert(n == c.nodes);
+        }
+    }
+
+    // Hashed perft: a fresh table per position, then one small table shared by all
+    // positions and reused for a second pass (hits, collisions and overwrites)
+    {
+        const char* fens[] = {
+            "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+            "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+            "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+        };
+        const int depth = 4;
+
+        std::vector<std::uint64_t> expect;
+        for (const char* fen : fens)
+        {
+            const bool parsed = b.set_fen(fen);
+            assert(parsed);
+            expect.push_back(ch::perft(b, depth));
+
+            ch::PerftHashTable fresh(1);
+            const std::uint64_t n = ch::perft_hashed(b, depth, fresh);
+            assert(n == expect.back());
+        }
+
+        ch::PerftHashTable shared(1);
+        for (int pass = 0; pass < 2; ++pass)
+            for (std::size_t i = 0; i < std::size(fens); ++i)
+            {
+                const bool parsed = b.set_fen(fens[i]);
+                assert(parsed);
+                const std::uint64_t n = ch::perft_hashed(b, depth, shared);
+                assert(n == expect[i]);
+            }
+
+        // Counts above 2^56 round-trip; the same key at another depth misses
+        ch::PerftHashTable tt(1);
+        const ch::Key key = 0x0123456789ABCDEFull;
+        const std::uint64_t big = (1ull << 62) + 12345;
+        tt.store(key, 9, big);
+
+        std::uint64_t got = 0, miss = 0;
+        const bool hit = tt.probe(key, 9, got);
+        const bool otherDepth = tt.probe(key, 8, miss);
+        const bool otherKey = tt.probe(key ^ 1, 9, miss);
+        assert(hit && got == big);
+        assert(!otherDepth && !otherKey);
+    }
+
+    // Check generator against make_move + in_check over perft walks. The last
+    // positions add castling with a rook check (both sides) and en-passant checks,
+    // direct and discovered.
+    {
+        struct CheckCase
+        {
+            const char* fen;
+            int depth;
+        };
+
+        const CheckCase cases[] = {
+            { "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 3 },
+            { "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1", 4 },
+            { "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1", 3 },
+            { "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8", 3 },
+            { "5k2/8/8/8/8/8/8/4K2R w K - 0 1", 2 },
+            { "3k4/8/8/8/8/8/8/R3K3 w Q - 0 1", 2 },
+            { "8/4k3/8/3pP3/8/8/8/4K3 w - d6 0 1", 2 },
+            { "8/8/8/K2pP2k/8/8/8/8 w - d6 0 1", 2 },
+        };
+
+        CheckKinds seen;
+        for (const CheckCase& c : cases)
+        {
+            const bool parsed = b.set_fen(c.fen);
+            assert(parsed);
+            walk_checks(b, c.depth, seen);
+        }
+        assert(seen.direct && seen.discovered && seen.promotion && seen.en_passant && seen.castling);
+    }
+
+    // Parallel divide matches the serial one move for move, for 1, 2 and all hardware threads
+    {
+        const char* fens[] = {
+            "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+            "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+        };
+        const unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+
+        for (const char* fen : fens)
+        {
+            const bool parsed = b.set_fen(fen);
+            assert(parsed);
+            const std::vector<ch::PerftDivideEntry> serial = ch::perft_divide(b, 4);
+
+            std::uint64_t total = 0;
+            for (const ch::PerftDivideEntry& e : serial) total += e.nodes;
+
+            for (int threads : { 1, 2, 0 })
+            {
+                const ch::PerftParallelResult res = ch::perft_divide_parallel(b, 4, threads);
+                assert(res.threads.size() == (threads > 0 ? static_cast<std::size_t>(threads) : hw));
+                assert(res.divide.size() == serial.size());
+
+                std::uint64_t divided = 0, byThread = 0;
+                for (std::size_t i = 0; i < serial.size(); ++i)
+                {
+                    assert(res.divide[i].move == serial[i].move);
+                    assert(res.divide[i].nodes == serial[i].nodes);
+                    divided += res.divide[i].nodes;
+                }
+                for (const ch::PerftThreadStats& t : res.threads) byThread += t.nodes;
+                assert(divided == total && byThread == total);
+            }
+        }
+    }
+
+    std::cout << "perft OK\n";
+    return 0;
+}
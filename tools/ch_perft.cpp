@@ -0,0 +1,115 @@
+/**
+ * @file ch_perft.cpp
+ * @brief Perft driver: per-move divide, total nodes and nodes per second.
+ *
+ * Usage:
+ *   ch_perft "<FEN>" <depth> [threads] [hashMB]
+ *   ch_perft startpos <depth> [threads] [hashMB]
+ *
+ * threads defaults to 1 (serial perft); 0 uses every hardware thread.
+ * hashMB > 0 caches subtree counts in a table of that size shared by all threads.
+ */
+#include "chess/core/ch_board.h"
+#include "chess/core/ch_move.h"
+#include "chess/core/ch_square.h"
+#include "chess/perft/ch_perft.h"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // UCI long algebraic (e2e4, e7e8q); @p b is the position the move is played from.
+    std::string move_to_uci(const ch::Board& b, ch::Move m)
+    {
+        std::string s = ch::sq_to_str(m.from()) + ch::sq_to_str(m.to());
+
+        // Promo code 0 means Knight, so decide "is promotion" from the piece and rank
+        const int toRank = ch::rank_of(m.to());
+        if (ch::kind_of(b.piece_on(m.from())) == ch::PieceKind::Pawn && (toRank == 0 || toRank == 7))
+            s.push_back("nbrq"[m.promo_code()]);
+        return s;
+    }
+
+    std::uint64_t nps(std::uint64_t nodes, double secs)
+    {
+        return secs > 0.0 ? static_cast<std::uint64_t>(static_cast<double>(nodes) / secs) : 0;
+    }
+
+    int usage(const char* argv0)
+    {
+        std::cerr << "usage: " << argv0 << " \"<FEN>\"|startpos <depth> [threads] [hashMB]\n";
+        return 2;
+    }
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc < 3 || argc > 5) return usage(argv[0]);
+
+    ch::Board b;
+    const std::string fen = argv[1];
+    if (fen == "startpos") b.set_startpos();
+    else if (!b.set_fen(fen.c_str()))
+    {
+        std::cerr << "invalid FEN: " << fen << "\n";
+        return 2;
+    }
+
+    const int depth = std::atoi(argv[2]);
+    if (depth <= 0) return usage(argv[0]);
+
+    const int threads = (argc >= 4) ? std::atoi(argv[3]) : 1;
+    const int hashMB = (argc >= 5) ? std::atoi(argv[4]) : 0;
+    if (threads < 0 || hashMB < 0) return usage(argv[0]);
+
+    std::unique_ptr<ch::PerftHashTable> tt;
+    if (hashMB > 0) tt = std::make_unique<ch::PerftHashTable>(static_cast<std::size_t>(hashMB));
+
+    std::vector<ch::PerftDivideEntry> divide;
+    std::vector<ch::PerftThreadStats> perThread;
+
+    const auto t0 = std::chrono::steady_clock::now();
+    if (threads == 1 && !tt)
+        divide = ch::perft_divide(b, depth);
+    else
+    {
+        auto res = ch::perft_divide_parallel(b, depth, threads, tt.get());
+        divide = std::move(res.divide);
+        perThread = std::move(res.threads);
+    }
+    const auto t1 = std::chrono::steady_clock::now();
+
+    std::uint64_t total = 0;
+    for (const auto& e : divide)
+    {
+        std::cout << move_to_uci(b, e.move) << ": " << e.nodes << "\n";
+        total += e.nodes;
+    }
+
+    const double secs = std::chrono::duration<double>(t1 - t0).count();
+    std::cout << "\nMoves: " << divide.size() << "\n"
+              << "Nodes: " << total << "\n"
+              << "Time:  " << secs << " s\n"
+              << "NPS:   " << nps(total, secs) << "\n";
+
+    if (!perThread.empty())
+    {
+        std::cout << "\nThreads: " << perThread.size() << "\n";
+        for (std::size_t i = 0; i < perThread.size(); ++i)
+        {
+            const auto& t = perThread[i];
+            std::cout << "  #" << std::setw(2) << i
+                      << "  tasks " << std::setw(6) << t.tasks
+                      << "  nodes " << std::setw(14) << t.nodes
+                      << "  NPS " << nps(t.nodes, t.seconds) << "\n";
+        }
+    }
+    return 0;
+}